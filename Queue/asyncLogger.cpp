@@ -0,0 +1,280 @@
+#include <iostream>
+#include <utility>
+#include <stdexcept>
+#include <system_error>
+#include <atomic>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <cstdio>
+#include <cstdarg>
+#include <cstring>
+#include <cstdint>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "mpmcRing.cpp"
+
+enum class logLevel : std::uint8_t { debug, info, warn, error };
+
+// what log() does when the ring is full
+enum class overflowPolicy { drop, block };
+
+// Asynchronous logger: callers format into a fixed-size record and push it onto an
+// mpmcRing (used with many producers and one consumer); a background thread drains
+// records in batches and hands each batch to a single writev(). The caller never takes
+// a lock or makes a syscall. Timestamp and level prefixes are formatted by the
+// background thread, off the hot path.
+//
+// Pending records are written when a batch fills up or, once the ring runs dry, when
+// the oldest pending record is flushInterval old (0 writes as soon as the ring is
+// empty). Messages longer than kTextBytes are truncated.
+class asyncLogger
+{
+public:
+    static constexpr std::size_t kTextBytes = 232;
+
+private:
+    enum class recordKind : std::uint8_t { text, flush };
+
+    struct record{
+        std::int64_t timeNs;            // system_clock, ns since epoch
+        std::uint32_t thread;
+        std::uint16_t len;
+        logLevel level;
+        recordKind kind;
+        char text[kTextBytes];
+    };
+
+    static constexpr std::size_t kMaxBatch = 256;  // 2 iovecs per record, below IOV_MAX
+    static constexpr std::size_t kPrefixBytes = 48;
+
+    mpmcRing<record> ring;
+    overflowPolicy policy;
+    std::chrono::nanoseconds flushInterval;
+    int fd;
+    std::thread writer;
+    std::atomic<bool> stopping{false};
+
+    std::atomic<std::uint64_t> droppedCount{0};
+    std::atomic<std::uint64_t> blockedCount{0};
+    std::atomic<std::uint64_t> writtenCount{0};
+    std::atomic<std::uint64_t> batchCount{0};
+    std::atomic<std::uint64_t> writeErrorCount{0};
+
+    static std::uint32_t threadTag(){
+        static std::atomic<std::uint32_t> next{1};
+        static thread_local std::uint32_t tag = next.fetch_add(1, std::memory_order_relaxed);
+        return tag;
+    }
+
+    static const char* levelName(logLevel level){
+        switch(level){
+            case logLevel::debug: return "DEBUG";
+            case logLevel::info: return "INFO ";
+            case logLevel::warn: return "WARN ";
+            default: return "ERROR";
+        }
+    }
+
+    bool push(record& r){
+        if(ring.tryEnqueue(r)){
+            return true;
+        }
+        if(policy == overflowPolicy::drop){
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        blockedCount.fetch_add(1, std::memory_order_relaxed);
+        while(!ring.tryEnqueue(r)){
+            std::this_thread::yield();
+        }
+        return true;
+    }
+
+    // one writev per batch, retried on partial writes
+    void writeBatch(const record* batch, std::size_t n){
+        if(n == 0){
+            return;
+        }
+        char prefixes[kMaxBatch][kPrefixBytes];
+        iovec iov[kMaxBatch * 2];
+        for(std::size_t i = 0; i < n; i++){
+            std::int64_t secs = batch[i].timeNs / 1000000000;
+            std::int64_t micros = batch[i].timeNs % 1000000000 / 1000;
+            int len = std::snprintf(prefixes[i], kPrefixBytes, "%lld.%06lld %s [%u] ",
+                                    static_cast<long long>(secs), static_cast<long long>(micros),
+                                    levelName(batch[i].level), batch[i].thread);
+            iov[2 * i].iov_base = prefixes[i];
+            iov[2 * i].iov_len = static_cast<std::size_t>(len);
+            iov[2 * i + 1].iov_base = const_cast<char*>(batch[i].text);
+            iov[2 * i + 1].iov_len = batch[i].len;
+        }
+
+        iovec* cur = iov;
+        int left = static_cast<int>(2 * n);
+        while(left > 0){
+            ssize_t w = ::writev(fd, cur, left);
+            if(w < 0){
+                if(errno == EINTR){
+                    continue;
+                }
+                writeErrorCount.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            std::size_t done = static_cast<std::size_t>(w);
+            while(left > 0 && done >= cur->iov_len){
+                done -= cur->iov_len;
+                cur++;
+                left--;
+            }
+            if(left > 0){
+                cur->iov_base = static_cast<char*>(cur->iov_base) + done;
+                cur->iov_len -= done;
+            }
+        }
+        writtenCount.fetch_add(n, std::memory_order_relaxed);
+        batchCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void writerLoop(){
+        std::vector<record> batch(kMaxBatch);
+        std::size_t n = 0;
+        std::chrono::steady_clock::time_point oldest;
+        record r;
+        for(;;){
+            bool stop = stopping.load(std::memory_order_acquire);
+            bool gotAny = false;
+            while(n < kMaxBatch && ring.tryDequeue(r)){
+                gotAny = true;
+                if(r.kind == recordKind::flush){
+                    writeBatch(batch.data(), n);
+                    n = 0;
+                    std::atomic<bool>* done;
+                    std::memcpy(&done, r.text, sizeof(done));
+                    done->store(true, std::memory_order_release);
+                    continue;
+                }
+                if(n == 0){
+                    oldest = std::chrono::steady_clock::now();
+                }
+                batch[n++] = r;
+            }
+            if(n == kMaxBatch ||
+               (n > 0 && std::chrono::steady_clock::now() - oldest >= flushInterval) ||
+               (n > 0 && stop)){
+                writeBatch(batch.data(), n);
+                n = 0;
+                continue;
+            }
+            if(stop && !gotAny){
+                return;
+            }
+            if(!gotAny){
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+        }
+    }
+
+public:
+    // ctor, appends to path; capacity is the ring size in records
+    asyncLogger(const std::string& path, std::size_t capacity = 1 << 14,
+                overflowPolicy policy = overflowPolicy::block,
+                std::chrono::nanoseconds flushInterval = std::chrono::milliseconds(1))
+        : ring(capacity), policy(policy), flushInterval(flushInterval){
+        fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if(fd < 0){
+            throw std::system_error(errno, std::generic_category(), "asyncLogger: open " + path);
+        }
+        writer = std::thread(&asyncLogger::writerLoop, this);
+    }
+
+    asyncLogger(const asyncLogger&) = delete;
+    asyncLogger& operator=(const asyncLogger&) = delete;
+
+    // destructor: writes everything already enqueued, then closes the file
+    ~asyncLogger(){
+        stopping.store(true, std::memory_order_release);
+        writer.join();
+        ::close(fd);
+    }
+
+    // false if the record was dropped (drop policy, ring full)
+    bool write(logLevel level, std::string_view msg){
+        record r;
+        r.timeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        r.thread = threadTag();
+        r.level = level;
+        r.kind = recordKind::text;
+        std::size_t len = msg.size() < kTextBytes - 1 ? msg.size() : kTextBytes - 1;
+        std::memcpy(r.text, msg.data(), len);
+        r.text[len++] = '\n';
+        r.len = static_cast<std::uint16_t>(len);
+        return push(r);
+    }
+
+    // printf-style
+    bool log(logLevel level, const char* fmt, ...) __attribute__((format(printf, 3, 4))){
+        record r;
+        r.timeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        r.thread = threadTag();
+        r.level = level;
+        r.kind = recordKind::text;
+        va_list args;
+        va_start(args, fmt);
+        int len = std::vsnprintf(r.text, kTextBytes, fmt, args);
+        va_end(args);
+        if(len < 0){
+            len = 0;
+        }
+        std::size_t n = static_cast<std::size_t>(len) < kTextBytes - 1 ? static_cast<std::size_t>(len)
+                                                                     : kTextBytes - 1;
+        r.text[n++] = '\n';
+        r.len = static_cast<std::uint16_t>(n);
+        return push(r);
+    }
+
+    // returns once everything this thread logged before the call is in the file
+    void flush(){
+        std::atomic<bool> done{false};
+        record r;
+        r.kind = recordKind::flush;
+        r.len = 0;
+        std::atomic<bool>* p = &done;
+        std::memcpy(r.text, &p, sizeof(p));
+        while(!ring.tryEnqueue(r)){
+            std::this_thread::yield();
+        }
+        while(!done.load(std::memory_order_acquire)){
+            std::this_thread::yield();
+        }
+    }
+
+    // records rejected because the ring was full (drop policy)
+    std::uint64_t dropped() const{
+        return droppedCount.load(std::memory_order_relaxed);
+    }
+
+    // calls that had to wait for space (block policy)
+    std::uint64_t blocked() const{
+        return blockedCount.load(std::memory_order_relaxed);
+    }
+
+    std::uint64_t written() const{
+        return writtenCount.load(std::memory_order_relaxed);
+    }
+
+    std::uint64_t batches() const{
+        return batchCount.load(std::memory_order_relaxed);
+    }
+
+    std::uint64_t writeErrors() const{
+        return writeErrorCount.load(std::memory_order_relaxed);
+    }
+};
@@ -0,0 +1,297 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <unistd.h>
+
+// 包含MPMC ring與async logger實現
+#include "asyncLogger.cpp"
+
+// 測試計數器
+int tests_passed = 0;
+int tests_total = 0;
+
+// 測試輔助宏
+#define TEST(name) \
+    void test_##name(); \
+    void run_test_##name() { \
+        tests_total++; \
+        std::cout << "Testing " #name "... "; \
+        try { \
+            test_##name(); \
+            tests_passed++; \
+            std::cout << "PASSED\n"; \
+        } catch (const std::exception& e) { \
+            std::cout << "FAILED: " << e.what() << "\n"; \
+        } catch (...) { \
+            std::cout << "FAILED: Unknown exception\n"; \
+        } \
+    } \
+    void test_##name()
+
+static std::string tempPath(const std::string& tag) {
+    return "/tmp/asyncLogger_test_" + tag + "_" + std::to_string(::getpid()) + ".log";
+}
+
+static std::vector<std::string> readLines(const std::string& path) {
+    std::ifstream in(path);
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(in, line)) lines.push_back(line);
+    return lines;
+}
+
+// ============= MPMC ring 測試 =============
+
+TEST(ring_fifo_and_bounds) {
+    mpmcRing<int> q(5);
+    assert(q.capacity() == 8);  // 取到2的次方
+    for (int i = 0; i < 8; i++) assert(q.tryEnqueue(i));
+    assert(!q.tryEnqueue(8));
+    try {
+        q.enqueue(8);
+        assert(false);
+    } catch (const std::overflow_error&) {
+        // 預期的異常
+    }
+    assert(q.size() == 8);
+
+    int v;
+    for (int i = 0; i < 8; i++) {
+        assert(q.tryDequeue(v) && v == i);
+        assert(q.tryEnqueue(100 + i));  // 環繞
+    }
+    for (int i = 0; i < 8; i++) assert(q.dequeue() == 100 + i);
+    assert(q.empty());
+    try {
+        q.dequeue();
+        assert(false);
+    } catch (const std::underflow_error&) {
+        // 預期的異常
+    }
+}
+
+TEST(ring_concurrent_producers_consumers) {
+    const int PRODUCERS = 4, CONSUMERS = 3, PER = 100000;
+    mpmcRing<std::uint64_t> q(256);
+    std::atomic<std::uint64_t> sum{0};
+    std::atomic<int> consumed{0};
+    std::vector<std::vector<std::uint64_t>> lastSeen(CONSUMERS, std::vector<std::uint64_t>(PRODUCERS, 0));
+
+    std::vector<std::thread> threads;
+    for (int c = 0; c < CONSUMERS; c++) {
+        threads.emplace_back([&, c] {
+            std::uint64_t v;
+            while (consumed.load() < PRODUCERS * PER) {
+                if (q.tryDequeue(v)) {
+                    // 同一個producer的值，單一consumer看到的順序是遞增的
+                    std::uint64_t p = v >> 32, i = v & 0xffffffff;
+                    assert(i + 1 > lastSeen[c][p]);
+                    lastSeen[c][p] = i + 1;
+                    sum.fetch_add(i);
+                    consumed.fetch_add(1);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (int p = 0; p < PRODUCERS; p++) {
+        threads.emplace_back([&, p] {
+            for (std::uint64_t i = 0; i < PER; i++) {
+                while (!q.tryEnqueue((std::uint64_t(p) << 32) | i)) std::this_thread::yield();
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    assert(sum.load() == std::uint64_t(PRODUCERS) * PER * (PER - 1) / 2);
+    assert(q.empty());
+}
+
+// ============= logger 測試 =============
+
+TEST(all_records_written_in_order) {
+    std::string path = tempPath("order");
+    std::remove(path.c_str());
+    const int THREADS = 4, PER = 5000;
+    {
+        asyncLogger log(path, 1024, overflowPolicy::block);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREADS; t++) {
+            threads.emplace_back([&, t] {
+                for (int i = 0; i < PER; i++) assert(log.log(logLevel::info, "t%d n%d", t, i));
+            });
+        }
+        for (auto& th : threads) th.join();
+        log.flush();
+        assert(log.written() == std::uint64_t(THREADS) * PER);
+        assert(log.dropped() == 0);
+        assert(log.batches() < log.written());  // 有批次寫入
+    }
+
+    auto lines = readLines(path);
+    assert(lines.size() == std::size_t(THREADS) * PER);
+    std::vector<int> next(THREADS, 0);
+    for (auto& line : lines) {
+        assert(line.find("INFO") != std::string::npos);
+        std::size_t at = line.rfind(" t");
+        int t, i;
+        assert(std::sscanf(line.c_str() + at, " t%d n%d", &t, &i) == 2);
+        assert(i == next[t]);  // 同一個thread保持順序
+        next[t]++;
+    }
+    std::remove(path.c_str());
+}
+
+TEST(flush_and_truncation) {
+    std::string path = tempPath("flush");
+    std::remove(path.c_str());
+    asyncLogger log(path, 64, overflowPolicy::block, std::chrono::seconds(10));
+    log.write(logLevel::warn, "first");
+    log.write(logLevel::error, std::string(1000, 'x'));
+    log.flush();  // 不等flush interval
+
+    auto lines = readLines(path);
+    assert(lines.size() == 2);
+    assert(lines[0].find("WARN") != std::string::npos);
+    assert(lines[0].substr(lines[0].size() - 5) == "first");
+    std::size_t xs = std::count(lines[1].begin(), lines[1].end(), 'x');
+    assert(xs == asyncLogger::kTextBytes - 1);  // 過長的訊息被截斷
+    std::remove(path.c_str());
+}
+
+TEST(drop_policy_counts) {
+    std::string path = tempPath("drop");
+    std::remove(path.c_str());
+    const int N = 200000;
+    std::uint64_t dropped = 0;
+    {
+        asyncLogger log(path, 4, overflowPolicy::drop);
+        int accepted = 0;
+        for (int i = 0; i < N; i++) {
+            if (log.log(logLevel::debug, "%d", i)) accepted++;
+        }
+        dropped = log.dropped();
+        assert(accepted + dropped == std::uint64_t(N));
+        assert(log.blocked() == 0);
+    }
+    // 被接受的紀錄全部寫入
+    assert(readLines(path).size() == N - dropped);
+    std::remove(path.c_str());
+}
+
+TEST(block_policy_counts) {
+    std::string path = tempPath("block");
+    std::remove(path.c_str());
+    const int N = 50000;
+    {
+        asyncLogger log(path, 4, overflowPolicy::block);
+        for (int i = 0; i < N; i++) log.log(logLevel::debug, "%d", i);
+        assert(log.dropped() == 0);
+        std::cout << "(blocked " << log.blocked() << " times) ";
+    }
+    assert(readLines(path).size() == std::size_t(N));
+    std::remove(path.c_str());
+}
+
+// ============= 性能測試 =============
+
+// 每次呼叫的延遲分佈
+template <typename LogFn>
+static std::vector<long long> measure(int threads, int perThread, LogFn logOne) {
+    std::vector<std::vector<long long>> lat(threads);
+    std::vector<std::thread> ts;
+    std::atomic<bool> go{false};
+    for (int t = 0; t < threads; t++) {
+        ts.emplace_back([&, t] {
+            lat[t].reserve(perThread);
+            while (!go.load()) std::this_thread::yield();
+            for (int i = 0; i < perThread; i++) {
+                auto a = std::chrono::steady_clock::now();
+                logOne(t, i);
+                auto b = std::chrono::steady_clock::now();
+                lat[t].push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(b - a).count());
+            }
+        });
+    }
+    go.store(true);
+    for (auto& th : ts) th.join();
+    std::vector<long long> all;
+    for (auto& l : lat) all.insert(all.end(), l.begin(), l.end());
+    std::sort(all.begin(), all.end());
+    return all;
+}
+
+TEST(per_call_latency) {
+    const int TOTAL = 400000;
+    for (int threads : {8, 32}) {
+        int per = TOTAL / threads;
+        std::string pathA = tempPath("benchA"), pathB = tempPath("benchB");
+        std::remove(pathA.c_str());
+        std::remove(pathB.c_str());
+
+        std::vector<long long> async;
+        {
+            asyncLogger log(pathA, 1 << 16, overflowPolicy::block);
+            async = measure(threads, per, [&](int t, int i) { log.log(logLevel::info, "thread %d message %d", t, i); });
+        }
+
+        // 基準：加鎖的ostream，相當於多個thread共用std::cout
+        std::vector<long long> locked;
+        {
+            std::ofstream out(pathB);
+            std::mutex mtx;
+            locked = measure(threads, per, [&](int t, int i) {
+                std::lock_guard<std::mutex> lock(mtx);
+                out << "thread " << t << " message " << i << '\n';
+            });
+        }
+        assert(readLines(pathA).size() == std::size_t(per) * threads);
+
+        auto pct = [](const std::vector<long long>& v, double p) { return v[std::size_t(p * (v.size() - 1))]; };
+        std::cout << "\n  " << threads << " threads: async p50 " << pct(async, 0.5) << "ns p99 " << pct(async, 0.99)
+                  << "ns max " << async.back() << "ns | mutex+ostream p50 " << pct(locked, 0.5) << "ns p99 "
+                  << pct(locked, 0.99) << "ns max " << locked.back() << "ns";
+        std::remove(pathA.c_str());
+        std::remove(pathB.c_str());
+    }
+    std::cout << " ";
+}
+
+// ============= 主測試函數 =============
+
+int main() {
+    std::cout << "=== AsyncLogger 測試套件 ===\n\n";
+
+    // 運行所有測試
+    run_test_ring_fifo_and_bounds();
+    run_test_ring_concurrent_producers_consumers();
+    run_test_all_records_written_in_order();
+    run_test_flush_and_truncation();
+    run_test_drop_policy_counts();
+    run_test_block_policy_counts();
+    run_test_per_call_latency();
+
+    // 測試結果
+    std::cout << "\n=== 測試結果 ===\n";
+    std::cout << "通過: " << tests_passed << "/" << tests_total << " 測試\n";
+
+    if (tests_passed == tests_total) {
+        std::cout << "🎉 所有測試通過！\n";
+        return 0;
+    } else {
+        std::cout << "❌ 有 " << (tests_total - tests_passed) << " 個測試失敗\n";
+        return 1;
+    }
+}
@@ -0,0 +1,356 @@
+#include <iostream>
+#include <utility>
+#include <stdexcept>
+#include <atomic>
+#include <optional>
+#include <thread>
+#include <coroutine>
+
+#include "circularQueue.cpp"
+
+// C++20 only: an awaitable bounded channel whose buffer is a circularQueue.
+//
+//   co_await ch.send(v)  suspends while the buffer is full, returns false if closed
+//   co_await ch.recv()   suspends while the buffer is empty, returns std::nullopt once
+//                        the channel is closed and drained
+//   ch.close()           wakes every waiter
+//
+// A channel of capacity 0 is a rendezvous: send completes only when a receiver takes
+// the value. Suspended coroutines are resumed through Executor::post(handle), so the
+// caller decides on which thread they continue. Channel state is guarded by a spinlock
+// held only for a few pointer updates, so an uncontended send/recv costs one atomic
+// test-and-set and never touches a mutex or the kernel.
+
+// resumes on the notifying thread
+struct inlineExecutor
+{
+    void post(std::coroutine_handle<> h){
+        h.resume();
+    }
+};
+
+// single-threaded run queue, drained by run(); its queue is a growing circularQueue
+class manualExecutor
+{
+private:
+    circularQueue<std::coroutine_handle<>> ready{64, ringMode::grow};
+
+public:
+    void post(std::coroutine_handle<> h){
+        ready.enqueue(h);
+    }
+
+    bool runOne(){
+        if(ready.empty()){
+            return false;
+        }
+        std::coroutine_handle<> h = ready.front();
+        ready.dequeue();
+        h.resume();
+        return true;
+    }
+
+    // returns the number of coroutines resumed
+    std::size_t run(){
+        std::size_t n = 0;
+        while(runOne()){
+            n++;
+        }
+        return n;
+    }
+
+    std::size_t pending() const{
+        return ready.size();
+    }
+};
+
+template <typename T, typename Executor = manualExecutor>
+class channel
+{
+private:
+    class spinLock
+    {
+    private:
+        std::atomic_flag flag = ATOMIC_FLAG_INIT;
+
+    public:
+        void lock(){
+            while(flag.test_and_set(std::memory_order_acquire)){
+                std::this_thread::yield();
+            }
+        }
+
+        void unlock(){
+            flag.clear(std::memory_order_release);
+        }
+    };
+
+    // waiter nodes live inside the suspended coroutine's awaiter
+    struct sendWaiter{
+        T* value;
+        bool ok;
+        std::coroutine_handle<> handle;
+        sendWaiter* next;
+    };
+
+    struct recvWaiter{
+        std::optional<T> value;
+        std::coroutine_handle<> handle;
+        recvWaiter* next;
+    };
+
+    template <typename W>
+    struct waitList{
+        W* head = nullptr;
+        W* tail = nullptr;
+
+        bool empty() const{
+            return head == nullptr;
+        }
+
+        void push(W* w){
+            w->next = nullptr;
+            if(tail == nullptr){
+                head = tail = w;
+            }
+            else{
+                tail->next = w;
+                tail = w;
+            }
+        }
+
+        W* pop(){
+            W* w = head;
+            head = w->next;
+            if(head == nullptr){
+                tail = nullptr;
+            }
+            return w;
+        }
+
+        W* takeAll(){
+            W* w = head;
+            head = tail = nullptr;
+            return w;
+        }
+    };
+
+    circularQueue<T> buffer;
+    spinLock lock;
+    waitList<sendWaiter> senders;
+    waitList<recvWaiter> receivers;
+    bool closed = false;
+    Executor& exec;
+
+public:
+    class sendAwaiter
+    {
+        friend class channel;
+
+    private:
+        channel& ch;
+        T value;
+        sendWaiter node;
+
+        sendAwaiter(channel& ch, T value) : ch(ch), value(std::move(value)){}
+
+    public:
+        bool await_ready() const noexcept{
+            return false;
+        }
+
+        // returning false resumes the caller immediately without a round trip
+        bool await_suspend(std::coroutine_handle<> h){
+            ch.lock.lock();
+            if(ch.closed){
+                ch.lock.unlock();
+                node.ok = false;
+                return false;
+            }
+            if(!ch.receivers.empty()){
+                // a receiver is parked, so the buffer is empty: hand the value over
+                recvWaiter* r = ch.receivers.pop();
+                ch.lock.unlock();
+                r->value.emplace(std::move(value));
+                node.ok = true;
+                ch.exec.post(r->handle);
+                return false;
+            }
+            if(!ch.buffer.isFull()){
+                ch.buffer.enqueue(std::move(value));
+                ch.lock.unlock();
+                node.ok = true;
+                return false;
+            }
+            node.value = &value;
+            node.ok = false;
+            node.handle = h;
+            ch.senders.push(&node);
+            ch.lock.unlock();
+            return true;
+        }
+
+        // true if the value was delivered, false if the channel was closed
+        bool await_resume() const noexcept{
+            return node.ok;
+        }
+    };
+
+    class recvAwaiter
+    {
+        friend class channel;
+
+    private:
+        channel& ch;
+        recvWaiter node;
+
+        explicit recvAwaiter(channel& ch) : ch(ch){}
+
+    public:
+        bool await_ready() const noexcept{
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> h){
+            ch.lock.lock();
+            if(!ch.buffer.empty()){
+                node.value.emplace(std::move(ch.buffer.front()));
+                ch.buffer.dequeue();
+                sendWaiter* s = nullptr;
+                if(!ch.senders.empty()){
+                    // a slot just opened up for the oldest parked sender
+                    s = ch.senders.pop();
+                    ch.buffer.enqueue(std::move(*s->value));
+                    s->ok = true;
+                }
+                ch.lock.unlock();
+                if(s != nullptr){
+                    ch.exec.post(s->handle);
+                }
+                return false;
+            }
+            if(!ch.senders.empty()){
+                // unbuffered channel: take the value straight from the sender
+                sendWaiter* s = ch.senders.pop();
+                ch.lock.unlock();
+                node.value.emplace(std::move(*s->value));
+                s->ok = true;
+                ch.exec.post(s->handle);
+                return false;
+            }
+            if(ch.closed){
+                ch.lock.unlock();
+                return false;
+            }
+            node.handle = h;
+            ch.receivers.push(&node);
+            ch.lock.unlock();
+            return true;
+        }
+
+        std::optional<T> await_resume(){
+            return std::move(node.value);
+        }
+    };
+
+    // ctor
+    channel(std::size_t cap, Executor& exec) : buffer(static_cast<int>(cap)), exec(exec){}
+
+    channel(const channel&) = delete;
+    channel& operator=(const channel&) = delete;
+
+    sendAwaiter send(T value){
+        return sendAwaiter(*this, std::move(value));
+    }
+
+    recvAwaiter recv(){
+        return recvAwaiter(*this);
+    }
+
+    // non-suspending variants for callers outside a coroutine
+    bool trySend(T value){
+        lock.lock();
+        if(closed){
+            lock.unlock();
+            return false;
+        }
+        if(!receivers.empty()){
+            recvWaiter* r = receivers.pop();
+            lock.unlock();
+            r->value.emplace(std::move(value));
+            exec.post(r->handle);
+            return true;
+        }
+        if(buffer.isFull()){
+            lock.unlock();
+            return false;
+        }
+        buffer.enqueue(std::move(value));
+        lock.unlock();
+        return true;
+    }
+
+    std::optional<T> tryRecv(){
+        std::optional<T> out;
+        sendWaiter* s = nullptr;
+        lock.lock();
+        if(!buffer.empty()){
+            out.emplace(std::move(buffer.front()));
+            buffer.dequeue();
+            if(!senders.empty()){
+                s = senders.pop();
+                buffer.enqueue(std::move(*s->value));
+            }
+        }
+        else if(!senders.empty()){
+            s = senders.pop();
+            out.emplace(std::move(*s->value));
+        }
+        lock.unlock();
+        if(s != nullptr){
+            s->ok = true;
+            exec.post(s->handle);
+        }
+        return out;
+    }
+
+    // no further sends; parked receivers get std::nullopt, parked senders get false.
+    // Values already buffered can still be received.
+    void close(){
+        lock.lock();
+        closed = true;
+        recvWaiter* r = receivers.takeAll();
+        sendWaiter* s = senders.takeAll();
+        lock.unlock();
+
+        while(r != nullptr){
+            recvWaiter* next = r->next;
+            exec.post(r->handle);
+            r = next;
+        }
+        while(s != nullptr){
+            sendWaiter* next = s->next;
+            s->ok = false;
+            exec.post(s->handle);
+            s = next;
+        }
+    }
+
+    bool isClosed(){
+        lock.lock();
+        bool c = closed;
+        lock.unlock();
+        return c;
+    }
+
+    std::size_t capacity(){
+        return buffer.capacity();
+    }
+
+    std::size_t size(){
+        lock.lock();
+        std::size_t n = buffer.size();
+        lock.unlock();
+        return n;
+    }
+};
@@ -0,0 +1,271 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <chrono>
+#include <exception>
+#include <memory>
+
+// 包含你的channel實現 (需要 -std=c++20)
+#include "channel.cpp"
+
+// 測試計數器
+int tests_passed = 0;
+int tests_total = 0;
+
+// 測試輔助宏
+#define TEST(name) \
+    void test_##name(); \
+    void run_test_##name() { \
+        tests_total++; \
+        std::cout << "Testing " #name "... "; \
+        try { \
+            test_##name(); \
+            tests_passed++; \
+            std::cout << "PASSED\n"; \
+        } catch (const std::exception& e) { \
+            std::cout << "FAILED: " << e.what() << "\n"; \
+        } catch (...) { \
+            std::cout << "FAILED: Unknown exception\n"; \
+        } \
+    } \
+    void test_##name()
+
+// 最簡單的coroutine型別：立即開始執行，結束時自動銷毀
+struct detachedTask {
+    struct promise_type {
+        detachedTask get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+// ============= 基本功能測試 =============
+
+detachedTask sendAll(channel<int>& ch, int from, int to, int& sent) {
+    for (int i = from; i < to; i++) {
+        if (!co_await ch.send(i)) co_return;
+        sent++;
+    }
+}
+
+detachedTask recvAll(channel<int>& ch, std::vector<int>& out) {
+    while (auto v = co_await ch.recv()) out.push_back(*v);
+}
+
+TEST(buffered_send_does_not_suspend) {
+    manualExecutor ex;
+    channel<int> ch(4, ex);
+    int sent = 0;
+    sendAll(ch, 0, 4, sent);
+    assert(sent == 4);  // 沒有經過executor就完成
+    assert(ch.size() == 4);
+    assert(ex.pending() == 0);
+
+    std::vector<int> got;
+    recvAll(ch, got);
+    assert((got == std::vector<int>{0, 1, 2, 3}));  // 之後在recv上掛起
+    assert(ch.size() == 0);
+
+    ch.close();  // 讓掛起的receiver結束
+    ex.run();
+}
+
+TEST(full_channel_suspends_sender) {
+    manualExecutor ex;
+    channel<int> ch(2, ex);
+    int sent = 0;
+    sendAll(ch, 0, 10, sent);
+    assert(sent == 2);  // 第三個send掛起
+
+    std::vector<int> got;
+    recvAll(ch, got);
+    ex.run();
+    assert(sent == 10);
+    assert((got == std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+
+    ch.close();
+    ex.run();
+}
+
+TEST(rendezvous_channel) {
+    manualExecutor ex;
+    channel<std::string> ch(0, ex);
+    std::vector<std::string> log;
+
+    [](channel<std::string>& ch, std::vector<std::string>& log) -> detachedTask {
+        log.push_back("send start");
+        bool ok = co_await ch.send("hello");
+        log.push_back(ok ? "send done" : "send failed");
+    }(ch, log);
+    assert((log == std::vector<std::string>{"send start"}));  // 沒有receiver就不能完成
+
+    [](channel<std::string>& ch, std::vector<std::string>& log) -> detachedTask {
+        auto v = co_await ch.recv();
+        log.push_back("recv " + *v);
+    }(ch, log);
+    ex.run();
+    assert((log == std::vector<std::string>{"send start", "recv hello", "send done"}));
+}
+
+TEST(close_wakes_all_waiters) {
+    manualExecutor ex;
+    channel<int> ch(1, ex);
+    int nulls = 0;
+    auto receiver = [](channel<int>& ch, int& nulls) -> detachedTask {
+        auto v = co_await ch.recv();
+        if (!v) nulls++;
+    };
+    receiver(ch, nulls);
+    receiver(ch, nulls);
+    receiver(ch, nulls);
+    ch.close();
+    assert(ex.run() == 3);
+    assert(nulls == 3);
+
+    // 已經關閉的channel不能再send
+    int sent = 0;
+    sendAll(ch, 0, 5, sent);
+    assert(sent == 0);
+    assert(!ch.trySend(1));
+
+    // 掛起中的sender收到false，緩衝區內的值仍然可以取出
+    channel<int> ch2(1, ex);
+    int sent2 = 0;
+    sendAll(ch2, 0, 5, sent2);
+    assert(sent2 == 1);
+    ch2.close();
+    ex.run();
+    assert(sent2 == 1);
+    std::vector<int> got;
+    recvAll(ch2, got);
+    assert((got == std::vector<int>{0}));
+}
+
+TEST(try_send_and_try_recv) {
+    manualExecutor ex;
+    channel<int> ch(2, ex);
+    assert(ch.trySend(1));
+    assert(ch.trySend(2));
+    assert(!ch.trySend(3));  // 滿了
+
+    int sent = 0;
+    sendAll(ch, 10, 11, sent);  // 掛起在滿的channel上
+    assert(sent == 0);
+
+    assert(ch.tryRecv() == 1);  // 把掛起的sender的值搬進緩衝區
+    ex.run();
+    assert(sent == 1);
+    assert(ch.tryRecv() == 2);
+    assert(ch.tryRecv() == 10);
+    assert(!ch.tryRecv().has_value());
+}
+
+TEST(many_producers_one_consumer) {
+    manualExecutor ex;
+    channel<int> ch(3, ex);
+    std::vector<int> sent(4, 0);
+    for (int p = 0; p < 4; p++) sendAll(ch, p * 1000, p * 1000 + 500, sent[p]);
+
+    std::vector<int> got;
+    recvAll(ch, got);
+    ex.run();
+    assert(got.size() == 2000);
+    for (int p = 0; p < 4; p++) {
+        assert(sent[p] == 500);
+        // 同一個producer的值保持順序
+        int last = -1;
+        for (int v : got) {
+            if (v / 1000 == p) {
+                assert(v > last);
+                last = v;
+            }
+        }
+    }
+    ch.close();
+    ex.run();
+}
+
+TEST(move_only_values) {
+    manualExecutor ex;
+    channel<std::unique_ptr<int>> ch(1, ex);
+    int total = 0;
+    [](channel<std::unique_ptr<int>>& ch) -> detachedTask {
+        for (int i = 1; i <= 5; i++) co_await ch.send(std::make_unique<int>(i));
+        ch.close();
+    }(ch);
+    [](channel<std::unique_ptr<int>>& ch, int& total) -> detachedTask {
+        while (auto v = co_await ch.recv()) total += **v;
+    }(ch, total);
+    ex.run();
+    assert(total == 15);
+}
+
+// ============= 性能測試 =============
+
+detachedTask pinger(channel<int>& out, channel<int>& in, int rounds, bool& done) {
+    for (int i = 0; i < rounds; i++) {
+        co_await out.send(i);
+        auto v = co_await in.recv();
+        assert(v && *v == i);
+    }
+    done = true;
+}
+
+detachedTask ponger(channel<int>& in, channel<int>& out) {
+    while (auto v = co_await in.recv()) co_await out.send(*v);
+}
+
+TEST(ping_pong_latency) {
+    const int ROUNDS = 1000000;
+    auto measure = [&](std::size_t cap) {
+        manualExecutor ex;
+        channel<int> ping(cap, ex), pong(cap, ex);
+        bool done = false;
+        auto t0 = std::chrono::steady_clock::now();
+        ponger(ping, pong);
+        pinger(ping, pong, ROUNDS, done);
+        ex.run();
+        auto t1 = std::chrono::steady_clock::now();
+        assert(done);
+        ping.close();
+        ex.run();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count() / double(ROUNDS);
+    };
+    double rendezvous = measure(0);
+    double buffered = measure(1);
+    std::cout << "\n  round trip: " << rendezvous << "ns (capacity 0), " << buffered
+              << "ns (capacity 1), " << ROUNDS << " rounds ";
+}
+
+// ============= 主測試函數 =============
+
+int main() {
+    std::cout << "=== Channel 測試套件 ===\n\n";
+
+    // 運行所有測試
+    run_test_buffered_send_does_not_suspend();
+    run_test_full_channel_suspends_sender();
+    run_test_rendezvous_channel();
+    run_test_close_wakes_all_waiters();
+    run_test_try_send_and_try_recv();
+    run_test_many_producers_one_consumer();
+    run_test_move_only_values();
+    run_test_ping_pong_latency();
+
+    // 測試結果
+    std::cout << "\n=== 測試結果 ===\n";
+    std::cout << "通過: " << tests_passed << "/" << tests_total << " 測試\n";
+
+    if (tests_passed == tests_total) {
+        std::cout << "🎉 所有測試通過！\n";
+        return 0;
+    } else {
+        std::cout << "❌ 有 " << (tests_total - tests_passed) << " 個測試失敗\n";
+        return 1;
+    }
+}
@@ -0,0 +1,142 @@
+#include <iostream>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+// Chase-Lev work-stealing deque (memory orders from Le, Pop, Cohen & Zappa Nardelli,
+// "Correct and Efficient Work-Stealing for Weak Memory Models", PPoPP'13).
+//
+// The owner thread pushes and pops at the bottom without contention; any other thread
+// may steal from the top with a CAS. The slots are a circular array indexed like
+// circularQueue (index & mask instead of % cap) that doubles when full. Retired arrays
+// are kept until the deque is destroyed because a thief may still be reading one.
+template <typename T>
+class chaseLevDeque
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "chaseLevDeque slots are atomics and need a trivially copyable T (e.g. a pointer)");
+
+private:
+    struct ring{
+        std::size_t cap;
+        std::size_t mask;
+        std::unique_ptr<std::atomic<T>[]> slots;
+
+        explicit ring(std::size_t cap) : cap(cap), mask(cap - 1), slots(new std::atomic<T>[cap]){}
+
+        T get(std::int64_t i) const{
+            return slots[static_cast<std::size_t>(i) & mask].load(std::memory_order_relaxed);
+        }
+
+        void put(std::int64_t i, T value){
+            slots[static_cast<std::size_t>(i) & mask].store(value, std::memory_order_relaxed);
+        }
+
+        ring* grow(std::int64_t bottom, std::int64_t top) const{
+            ring* bigger = new ring(cap * 2);
+            for(std::int64_t i = top; i < bottom; i++){
+                bigger->put(i, get(i));
+            }
+            return bigger;
+        }
+    };
+
+    alignas(64) std::atomic<std::int64_t> top;
+    alignas(64) std::atomic<std::int64_t> bottom;
+    std::atomic<ring*> buffer;
+    std::vector<std::unique_ptr<ring>> rings;     // owner only: current + retired arrays
+
+    static std::size_t roundPow2(std::size_t n){
+        std::size_t p = 1;
+        while(p < n){
+            p <<= 1;
+        }
+        return p;
+    }
+
+public:
+    // ctor, cap is rounded up to a power of two
+    explicit chaseLevDeque(std::size_t cap = 64) : top(0), bottom(0){
+        rings.emplace_back(new ring(roundPow2(cap == 0 ? 1 : cap)));
+        buffer.store(rings.back().get(), std::memory_order_relaxed);
+    }
+
+    chaseLevDeque(const chaseLevDeque&) = delete;
+    chaseLevDeque& operator=(const chaseLevDeque&) = delete;
+
+    // owner only
+    void push(T value){
+        std::int64_t b = bottom.load(std::memory_order_relaxed);
+        std::int64_t t = top.load(std::memory_order_acquire);
+        ring* a = buffer.load(std::memory_order_relaxed);
+        if(b - t > static_cast<std::int64_t>(a->cap) - 1){
+            rings.emplace_back(a->grow(b, t));
+            a = rings.back().get();
+            buffer.store(a, std::memory_order_release);
+        }
+        a->put(b, value);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    // owner only, LIFO end
+    bool pop(T& out){
+        std::int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        ring* a = buffer.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t t = top.load(std::memory_order_relaxed);
+
+        if(t > b){
+            // empty
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+        out = a->get(b);
+        if(t == b){
+            // last element: race against thieves for it
+            bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                   std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    // any thread, FIFO end; false if empty or another thread won the race
+    bool steal(T& out){
+        std::int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t b = bottom.load(std::memory_order_acquire);
+        if(t >= b){
+            return false;
+        }
+        ring* a = buffer.load(std::memory_order_acquire);
+        T value = a->get(t);
+        if(!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                        std::memory_order_relaxed)){
+            return false;
+        }
+        out = value;
+        return true;
+    }
+
+    // snapshot, may be stale under concurrency
+    std::size_t size() const{
+        std::int64_t b = bottom.load(std::memory_order_relaxed);
+        std::int64_t t = top.load(std::memory_order_relaxed);
+        return b > t ? static_cast<std::size_t>(b - t) : 0;
+    }
+
+    bool empty() const{
+        return size() == 0;
+    }
+
+    std::size_t capacity() const{
+        return buffer.load(std::memory_order_relaxed)->cap;
+    }
+};
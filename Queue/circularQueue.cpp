@@ -4,10 +4,18 @@
 #include <limits>
 #include <type_traits>
 #include <stdexcept>
+#include <algorithm>
 
-template <typename T>
+#include "../common/containerStats.cpp"
 
-class circularQueue
+// what enqueue does when count == cap
+//   bounded   : throw std::overflow_error (original behaviour)
+//   overwrite : evict the oldest element, never throws (flight-recorder ring)
+//   grow      : reallocate a larger buffer and unwrap the contents to index 0
+enum class ringMode { bounded, overwrite, grow };
+
+template <typename T, typename Stats = defaultStatsRecorder>
+class circularQueue : private Stats
 {
 private:
     T* data;
@@ -15,13 +23,97 @@ private:
     std::size_t frontIdx;
     std::size_t rearIdx;
     std::size_t count;
+    ringMode mode = ringMode::bounded;
+    std::size_t droppedCount = 0;
+    double growth = 2.0;
+
+    void resize(std::size_t newCap){
+        if(newCap <= cap){
+            return;
+        }
+        T* newData = new T[newCap];
+        try
+        {
+            for(std::size_t i = 0; i < count; i++){
+                std::size_t idx = (frontIdx + i) % cap;
+                newData[i] = std::move_if_noexcept(data[idx]);
+            }
+        }
+        catch(...)
+        {
+            delete [] newData;
+            throw;
+        }
+
+        delete [] data;
+        data = newData;
+        cap = newCap;
+        frontIdx = 0;
+        rearIdx = count % cap;
+        this->recordResize(count * sizeof(T));
+    }
+
+    std::size_t calculateNewCap(){
+        if(cap == 0){
+            return 1;
+        }
+
+        std::size_t maxCap = std::numeric_limits<size_t>::max() / sizeof(T);
+        if(cap > maxCap / growth){
+            return maxCap;
+        }
+        return static_cast<std::size_t>(cap * growth);
+    }
+
+    // make room for one more element according to the mode, returns the slot to write
+    std::size_t reserveSlot(){
+        if(count == cap && mode == ringMode::grow){
+            resize(calculateNewCap());
+        }
+        if(count == cap && mode != ringMode::overwrite){
+            this->recordOverflow();
+            throw std::overflow_error("Queue is full");
+        }
+        return rearIdx;
+    }
+
+    // the slot at rearIdx has been written; in overwrite mode a full ring drops its oldest
+    void commitSlot(){
+        if(++rearIdx == cap){
+            rearIdx = 0;
+        }
+        if(count == cap){
+            frontIdx = rearIdx;
+            droppedCount++;
+        }
+        else{
+            count++;
+        }
+        this->recordInsert(count);
+    }
 
 public:
+    // occupancy / resize telemetry, see containerStats.cpp
+    using Stats::stats;
+    using Stats::resetStats;
+    using Stats::statsEnabled;
+
+    // a contiguous run of slots inside the ring buffer
+    struct span{
+        T* ptr;
+        std::size_t len;
+    };
+
     // deafult constructor
     explicit circularQueue(int cap): cap(cap), frontIdx(0), rearIdx(0), count(0){
         data = new T[cap];
     }
 
+    // ctor with overflow mode
+    circularQueue(int cap, ringMode mode) : circularQueue(cap) {
+        setOverflowMode(mode);
+    }
+
     // ctor
     circularQueue(int cap, T defaultValue) : circularQueue(cap) {
         for(int i = 0; i < cap; i++){
@@ -29,21 +121,37 @@ public:
         }
     }
 
-    // copy ctor
-    circularQueue(const circularQueue& other) : cap(other.cap), frontIdx(0), rearIdx(0), count(0) {
+    // copy ctor: copies the elements directly, so the copy's stats match the source's
+    // instead of recording every element again
+    circularQueue(const circularQueue& other) : Stats(other), cap(other.cap), frontIdx(0),
+        rearIdx(other.cap == 0 ? 0 : other.count % other.cap), count(other.count),
+        mode(other.mode), droppedCount(other.droppedCount) {
         data = new T[cap];
-        for(int i = 0; i < other.count; i++){
-            enqueue(other.data[(other.frontIdx + i) % other.cap]);
+        try
+        {
+            for(std::size_t i = 0; i < count; i++){
+                data[i] = other.data[(other.frontIdx + i) % other.cap];
+            }
+        }
+        catch(...)
+        {
+            delete [] data;
+            throw;
         }
     }
 
     // move ctor
     circularQueue(circularQueue&& other) noexcept : 
+        Stats(),
         data(std::exchange(other.data, nullptr)), 
         cap(std::exchange(other.cap, 0)),
         frontIdx(std::exchange(other.frontIdx, 0)), 
         rearIdx(std::exchange(other.rearIdx, 0)), 
-        count(std::exchange(other.count, 0)){}
+        count(std::exchange(other.count, 0)),
+        mode(std::exchange(other.mode, ringMode::bounded)),     // overwrite needs cap > 0
+        droppedCount(std::exchange(other.droppedCount, 0)){
+        this->swapStats(other);
+    }
 
     // copy & move assignment
     circularQueue& operator=(circularQueue other){
@@ -62,39 +170,80 @@ public:
         std::swap(frontIdx, other.frontIdx);
         std::swap(rearIdx, other.rearIdx);
         std::swap(count, other.count);
+        std::swap(mode, other.mode);
+        std::swap(droppedCount, other.droppedCount);
+        this->swapStats(other);
     }
 
     void enqueue(const T& value){
-        if(count == cap){
-            throw std::overflow_error("Queue is full");
-        }
-        data[rearIdx] = value;
-        rearIdx = (rearIdx + 1) % cap;
-        count++;
+        std::size_t idx = reserveSlot();
+        data[idx] = value;
+        commitSlot();
+    }
+
+    void enqueue(T&& value){
+        std::size_t idx = reserveSlot();
+        data[idx] = std::move(value);
+        commitSlot();
     }
 
     void dequeue(){
         if(count == 0){
+            this->recordUnderflow();
+            throw std::underflow_error("Queue is empty");
+        }
+        if(++frontIdx == cap){
+            frontIdx = 0;
+        }
+        count--;
+    }
+
+    // remove the newest element, so the ring can also serve as a deque (monotonic queues)
+    void dequeueBack(){
+        if(count == 0){
+            this->recordUnderflow();
             throw std::underflow_error("Queue is empty");
         }
-        frontIdx = (frontIdx + 1) % cap;
+        rearIdx = (rearIdx == 0 ? cap : rearIdx) - 1;
         count--;
     }
 
     const T& front() const{
         if(count == 0){
-            throw std::runtime_error("Queue is empty");
+            this->recordUnderflow();
+            throw std::underflow_error("Queue is empty");
+        }
+        return data[frontIdx];
+    }
+
+    // mutable access so the front element can be moved out before dequeue()
+    T& front(){
+        if(count == 0){
+            this->recordUnderflow();
+            throw std::underflow_error("Queue is empty");
         }
         return data[frontIdx];
     }
 
     const T& back() const{
         if(count == 0){
-            throw std::runtime_error("Queue is empty");
+            this->recordUnderflow();
+            throw std::underflow_error("Queue is empty");
         }
         return data[(rearIdx - 1 + cap) % cap];
     }
 
+    // i-th element from the front, unchecked
+    T& operator[](std::size_t i){
+        std::size_t idx = frontIdx + i;
+        return data[idx >= cap ? idx - cap : idx];
+    }
+
+    const T& operator[](std::size_t i) const{
+        std::size_t idx = frontIdx + i;
+        return data[idx >= cap ? idx - cap : idx];
+    }
+
     bool empty() const{
         return count == 0;
     }
@@ -111,9 +260,127 @@ public:
         return count;
     }
 
+    ringMode overflowMode() const{
+        return mode;
+    }
+
+    // overwrite needs at least one slot to overwrite
+    void setOverflowMode(ringMode newMode){
+        if(newMode == ringMode::overwrite && cap == 0){
+            throw std::invalid_argument("overwrite mode needs a positive capacity");
+        }
+        mode = newMode;
+    }
+
+    // number of elements evicted by enqueue in overwrite mode since construction or clear()
+    std::size_t dropped() const{
+        return droppedCount;
+    }
+
+    // copy the current contents oldest-first into out, returns the end of the output range
+    // walks the (at most two) contiguous segments, so no per-element modulo
+    template <typename OutputIt>
+    OutputIt snapshot(OutputIt out) const{
+        std::size_t firstLen = count < cap - frontIdx ? count : cap - frontIdx;
+        for(std::size_t i = 0; i < firstLen; i++){
+            *out++ = data[frontIdx + i];
+        }
+        for(std::size_t i = 0; i < count - firstLen; i++){
+            *out++ = data[i];
+        }
+        return out;
+    }
+
+    // occupied slots oldest-first: [frontIdx, cap) then the wrapped part [0, ...)
+    std::pair<span, span> readable_spans(){
+        std::size_t firstLen = std::min(count, cap - frontIdx);
+        return std::make_pair(span{data + frontIdx, firstLen}, span{data, count - firstLen});
+    }
+
+    // free slots in enqueue order: [rearIdx, cap) then the wrapped part [0, ...)
+    std::pair<span, span> writable_spans(){
+        std::size_t freeLen = cap - count;
+        std::size_t firstLen = std::min(freeLen, cap - rearIdx);
+        return std::make_pair(span{data + rearIdx, firstLen}, span{data, freeLen - firstLen});
+    }
+
+    // mark n elements at the front as consumed (after reading them through readable_spans)
+    void commit_read(std::size_t n){
+        if(n > count){
+            this->recordUnderflow();
+            throw std::underflow_error("commit_read past the end of the queue");
+        }
+        if(n == 0){
+            return;
+        }
+        frontIdx = (frontIdx + n) % cap;
+        count -= n;
+    }
+
+    // mark n slots at the rear as filled (after writing them through writable_spans)
+    void commit_write(std::size_t n){
+        if(n > cap - count){
+            this->recordOverflow();
+            throw std::overflow_error("commit_write past the free space of the queue");
+        }
+        if(n == 0){
+            return;
+        }
+        rearIdx = (rearIdx + n) % cap;
+        count += n;
+        this->recordInsert(count);
+    }
+
+    // copy up to n elements from src, returns how many were taken
+    // bounded mode stops at the free space; overwrite mode takes all n and evicts the oldest;
+    // grow mode takes all n and reallocates at most once
+    std::size_t enqueue_bulk(const T* src, std::size_t n){
+        std::size_t taken = n;
+        if(mode == ringMode::grow && n > cap - count){
+            resize(std::max(calculateNewCap(), count + n));
+        }
+        if(mode == ringMode::overwrite && n > cap - count){
+            if(n >= cap){
+                droppedCount += count + (n - cap);
+                src += n - cap;
+                n = cap;
+                frontIdx = rearIdx = 0;
+                count = 0;
+            }
+            else{
+                std::size_t evict = n - (cap - count);
+                droppedCount += evict;
+                commit_read(evict);
+            }
+        }
+        else if(n > cap - count){
+            n = taken = cap - count;
+        }
+
+        std::pair<span, span> spans = writable_spans();
+        std::size_t firstLen = std::min(n, spans.first.len);
+        std::copy(src, src + firstLen, spans.first.ptr);
+        std::copy(src + firstLen, src + n, spans.second.ptr);
+        commit_write(n);
+        return taken;
+    }
+
+    // move up to n elements into dst oldest-first, returns how many were moved
+    std::size_t dequeue_bulk(T* dst, std::size_t n){
+        n = std::min(n, count);
+        std::pair<span, span> spans = readable_spans();
+        std::size_t firstLen = std::min(n, spans.first.len);
+        std::move(spans.first.ptr, spans.first.ptr + firstLen, dst);
+        std::move(spans.second.ptr, spans.second.ptr + (n - firstLen), dst + firstLen);
+        commit_read(n);
+        return n;
+    }
+
+    // also resets dropped()
     void clear(){
         frontIdx = rearIdx = 0;
         count = 0;
+        droppedCount = 0;
     }
 
     void print() const{
@@ -4,9 +4,13 @@
 #include <stdexcept>
 #include <string>
 #include <utility>
+#include <iterator>
+#include <chrono>
+#include <deque>
 
 // 包含你的circular queue實現
 #include "circularQueue.cpp"
+#include "queue.cpp"
 
 // 測試計數器
 int tests_passed = 0;
@@ -475,6 +479,296 @@ TEST(boundary_conditions) {
     }
 }
 
+// ============= 覆寫模式測試 =============
+
+TEST(overwrite_mode) {
+    circularQueue<int> q(3, ringMode::overwrite);
+    assert(q.overflowMode() == ringMode::overwrite);
+
+    for (int i = 1; i <= 5; i++) {
+        q.enqueue(i);  // 滿了之後不拋異常，而是覆蓋最舊的元素
+    }
+
+    assert(q.isFull());
+    assert(q.size() == 3);
+    assert(q.dropped() == 2);
+    assert(q.front() == 3);
+    assert(q.back() == 5);
+
+    // 出隊後恢復正常行為
+    q.dequeue();
+    q.enqueue(6);
+    assert(q.dropped() == 2);
+    assert(q.front() == 4);
+    assert(q.back() == 6);
+
+    // clear()之後丟棄計數重新開始
+    circularQueue<int> again(q);
+    again.clear();
+    assert(again.empty() && again.dropped() == 0);
+
+    // 切回bounded模式後應該拋出overflow
+    q.setOverflowMode(ringMode::bounded);
+    try {
+        q.enqueue(7);
+        assert(false);
+    } catch (const std::overflow_error&) {
+        // 預期的異常
+    }
+
+    // 容量0沒有東西可以覆蓋，在建構時就拒絕
+    try {
+        circularQueue<int> none(0, ringMode::overwrite);
+        assert(false);
+    } catch (const std::invalid_argument&) {
+        // 預期的異常
+    }
+    circularQueue<int> zero(0);
+    try {
+        zero.setOverflowMode(ringMode::overwrite);
+        assert(false);
+    } catch (const std::invalid_argument&) {
+        // 預期的異常
+    }
+}
+
+TEST(snapshot) {
+    circularQueue<int> q(4, ringMode::overwrite);
+
+    std::vector<int> out;
+    q.snapshot(std::back_inserter(out));
+    assert(out.empty());
+
+    // 製造環繞狀態
+    for (int i = 0; i < 7; i++) {
+        q.enqueue(i);
+    }
+    q.snapshot(std::back_inserter(out));
+    assert((out == std::vector<int>{3, 4, 5, 6}));
+
+    // 輸出到原生陣列
+    int raw[4] = {0};
+    int* end = q.snapshot(raw);
+    assert(end == raw + 4);
+    assert(raw[0] == 3 && raw[3] == 6);
+
+    // 拷貝保留模式和丟棄計數
+    circularQueue<int> copy = q;
+    assert(copy.overflowMode() == ringMode::overwrite);
+    assert(copy.dropped() == 3);
+}
+
+// ============= 區段視圖與批量傳輸測試 =============
+
+TEST(readable_and_writable_spans) {
+    circularQueue<int> q(5);
+
+    // 空隊列：全部空間可寫，且只有一段
+    auto w = q.writable_spans();
+    assert(w.first.len == 5 && w.second.len == 0);
+    auto r = q.readable_spans();
+    assert(r.first.len == 0 && r.second.len == 0);
+
+    // 製造環繞狀態：front在索引3
+    for (int i = 0; i < 5; i++) q.enqueue(i);
+    q.dequeue(); q.dequeue(); q.dequeue();
+    q.enqueue(5); q.enqueue(6);  // 5,6寫入索引0,1
+
+    r = q.readable_spans();
+    assert(r.first.len == 2 && r.first.ptr[0] == 3 && r.first.ptr[1] == 4);
+    assert(r.second.len == 2 && r.second.ptr[0] == 5 && r.second.ptr[1] == 6);
+
+    w = q.writable_spans();
+    assert(w.first.len == 1 && w.second.len == 0);
+
+    // 直接寫入再提交
+    w.first.ptr[0] = 7;
+    q.commit_write(1);
+    assert(q.isFull());
+    assert(q.back() == 7);
+
+    q.commit_read(3);
+    assert(q.front() == 6);
+    assert(q.size() == 2);
+
+    try {
+        q.commit_read(3);
+        assert(false);
+    } catch (const std::underflow_error&) {
+        // 預期的異常
+    }
+    try {
+        q.commit_write(4);
+        assert(false);
+    } catch (const std::overflow_error&) {
+        // 預期的異常
+    }
+}
+
+TEST(bulk_transfer) {
+    circularQueue<int> q(8);
+    int src[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    int dst[10] = {0};
+
+    assert(q.enqueue_bulk(src, 6) == 6);
+    assert(q.dequeue_bulk(dst, 4) == 4);
+    assert(dst[0] == 0 && dst[3] == 3);
+
+    // bounded模式只收下剩餘空間(6)，寫入跨越環繞點
+    assert(q.enqueue_bulk(src, 10) == 6);
+    assert(q.isFull());
+    assert(q.front() == 4);
+    assert(q.back() == 5);
+
+    assert(q.dequeue_bulk(dst, 10) == 8);
+    assert(dst[0] == 4 && dst[1] == 5 && dst[2] == 0 && dst[7] == 5);
+    assert(q.empty());
+
+    // overwrite模式：保留最後cap個
+    circularQueue<int> ring(4, ringMode::overwrite);
+    ring.enqueue(100);
+    assert(ring.enqueue_bulk(src, 10) == 10);
+    assert(ring.dropped() == 7);
+    assert(ring.front() == 6 && ring.back() == 9);
+
+    ring.dequeue();
+    assert(ring.enqueue_bulk(src, 2) == 2);
+    assert(ring.dropped() == 8);
+    assert(ring.front() == 8 && ring.back() == 1);
+}
+
+TEST(bulk_performance) {
+    const std::size_t CAP = 4096;
+    const std::size_t BATCH = 256;
+    const int ROUNDS = 20000;
+    circularQueue<int> q(CAP);
+    std::vector<int> buf(BATCH, 1);
+    long long sum = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (std::size_t i = 0; i < BATCH; i++) q.enqueue(buf[i]);
+        for (std::size_t i = 0; i < BATCH; i++) {
+            sum += q.front();
+            q.dequeue();
+        }
+    }
+    auto mid = std::chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; r++) {
+        q.enqueue_bulk(buf.data(), BATCH);
+        q.dequeue_bulk(buf.data(), BATCH);
+        sum += buf[0];
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    auto perElement = std::chrono::duration_cast<std::chrono::microseconds>(mid - start);
+    auto bulk = std::chrono::duration_cast<std::chrono::microseconds>(end - mid);
+    std::cout << "\n  per-element: " << perElement.count() << "us, bulk: " << bulk.count()
+              << "us (" << ROUNDS * BATCH << " elements, checksum " << sum << ") ";
+    assert(q.empty());
+}
+
+// ============= 自動擴容模式測試 =============
+
+TEST(grow_mode_unwraps) {
+    circularQueue<int> q(4, ringMode::grow);
+
+    // 製造環繞狀態後再擴容
+    for (int i = 0; i < 4; i++) q.enqueue(i);
+    q.dequeue(); q.dequeue();
+    q.enqueue(4); q.enqueue(5);
+    assert(q.isFull());
+
+    q.enqueue(6);  // 觸發resize，內容應該從索引0開始
+    assert(q.capacity() == 8);
+    assert(q.size() == 5);
+    auto r = q.readable_spans();
+    assert(r.first.len == 5 && r.second.len == 0);
+    assert(r.first.ptr[0] == 2 && r.first.ptr[4] == 6);
+
+    // 批量寫入只擴容一次
+    int src[20];
+    for (int i = 0; i < 20; i++) src[i] = 100 + i;
+    assert(q.enqueue_bulk(src, 20) == 20);
+    assert(q.size() == 25);
+    assert(q.capacity() == 25);
+    assert(q.front() == 2 && q.back() == 119);
+}
+
+TEST(grow_mode_strings) {
+    circularQueue<std::string> q(1, ringMode::grow);
+    for (int i = 0; i < 100; i++) {
+        q.enqueue("s" + std::to_string(i));
+        if (i % 3 == 0) q.dequeue();
+    }
+    assert(q.size() == 66);
+    assert(q.front() == "s34");
+    assert(q.back() == "s99");
+}
+
+TEST(dequeue_back) {
+    circularQueue<int> q(3);
+    q.enqueue(1); q.enqueue(2); q.enqueue(3);
+    q.dequeue();
+    q.enqueue(4);  // rearIdx環繞到1
+
+    q.dequeueBack();
+    assert(q.back() == 3);
+    q.dequeueBack();
+    assert(q.back() == 2);  // rearIdx從0退回到最後一格
+    assert(q.front() == 2 && q.size() == 1);
+
+    q.enqueue(5); q.enqueue(6);
+    assert(q.isFull() && q.back() == 6);
+    q.dequeueBack(); q.dequeueBack(); q.dequeueBack();
+    assert(q.empty());
+
+    try {
+        q.dequeueBack();
+        assert(false);
+    } catch (const std::underflow_error&) {
+        // 預期的異常
+    }
+}
+
+TEST(churn_performance) {
+    // 穩態：維持LIVE個元素，反覆enqueue/dequeue
+    const int LIVE = 1000;
+    const int OPS = 2000000;
+
+    auto bench = [&](const char* name, auto& c, auto push, auto pop) {
+        for (int i = 0; i < LIVE; i++) push(c, i);
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < OPS; i++) {
+            push(c, i);
+            pop(c);
+        }
+        auto end = std::chrono::steady_clock::now();
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        std::cout << "\n  " << name << ": " << (double)ns / OPS << " ns/op";
+    };
+
+    circularQueue<int> ring(1, ringMode::grow);
+    bench("circularQueue(grow)", ring,
+          [](circularQueue<int>& c, int v) { c.enqueue(v); },
+          [](circularQueue<int>& c) { c.dequeue(); });
+
+    ::queue<int> linear(1);
+    bench("queue", linear,
+          [](::queue<int>& c, int v) { c.enqueue(v); },
+          [](::queue<int>& c) { c.dequeue(); });
+
+    std::deque<int> dq;
+    bench("std::deque", dq,
+          [](std::deque<int>& c, int v) { c.push_back(v); },
+          [](std::deque<int>& c) { c.pop_front(); });
+
+    // 環形緩衝區不會因為churn而持續擴容
+    std::cout << "\n  ring capacity after churn: " << ring.capacity() << " ";
+    assert(ring.capacity() <= 2 * LIVE);
+    assert(ring.size() == LIVE && linear.size() == LIVE && dq.size() == LIVE);
+}
+
 // ============= 主測試函數 =============
 
 int main() {
@@ -499,6 +793,15 @@ int main() {
     run_test_string_operations();
     run_test_large_scale_operations();
     run_test_boundary_conditions();
+    run_test_overwrite_mode();
+    run_test_snapshot();
+    run_test_readable_and_writable_spans();
+    run_test_bulk_transfer();
+    run_test_bulk_performance();
+    run_test_grow_mode_unwraps();
+    run_test_grow_mode_strings();
+    run_test_dequeue_back();
+    run_test_churn_performance();
     
     // 測試結果
     std::cout << "\n=== 測試結果 ===\n";
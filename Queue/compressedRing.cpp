@@ -0,0 +1,276 @@
+#include <iostream>
+#include <utility>
+#include <stdexcept>
+#include <iterator>
+#include <type_traits>
+#include <cstring>
+#include <cstdint>
+
+#include "circularQueue.cpp"
+
+// Ring of (timestamp, value) samples compressed in fixed-size blocks, for long metric
+// histories. Each block stores its first sample verbatim; every following sample is
+//
+//   timestamp  zigzag varint of the delta-of-delta (a steady interval costs one byte)
+//   value      XOR with the previous value's bits, stored as one control byte holding
+//              the number of trailing zero bytes (8 = unchanged) plus a varint of the rest
+//
+// Blocks live in a circularQueue<block>; when the ring is full the oldest block, with
+// all of its samples, is dropped. Iterators decode one block at a time, forward only.
+// V is any 8-byte trivially copyable type (int64_t, double, ...); consecutive timestamp
+// deltas must fit in an int64_t.
+template <typename V = std::int64_t, std::size_t BlockBytes = 256>
+class compressedRing
+{
+    static_assert(sizeof(V) == 8 && std::is_trivially_copyable<V>::value,
+                  "compressedRing stores 8-byte trivially copyable values");
+
+public:
+    struct sample{
+        std::int64_t time;
+        V value;
+    };
+
+private:
+    static constexpr std::size_t kMaxSampleBytes = 10 + 1 + 10;
+    static constexpr unsigned char kUnchanged = 8;
+    static_assert(BlockBytes >= kMaxSampleBytes, "block too small for one sample");
+
+    struct block{
+        std::int64_t firstTime;
+        std::uint64_t firstBits;
+        std::uint32_t count;
+        std::uint32_t used;
+        unsigned char bytes[BlockBytes];
+    };
+
+    circularQueue<block> blocks;
+    std::size_t sampleCount;
+    std::size_t droppedCount;
+    // encoder state of the newest block
+    std::int64_t lastTime;
+    std::int64_t lastDelta;
+    std::uint64_t lastBits;
+
+    static std::uint64_t toBits(const V& v){
+        std::uint64_t b;
+        std::memcpy(&b, &v, sizeof(b));
+        return b;
+    }
+
+    static V fromBits(std::uint64_t b){
+        V v;
+        std::memcpy(&v, &b, sizeof(v));
+        return v;
+    }
+
+    static std::uint64_t zigzag(std::int64_t v){
+        return (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63);
+    }
+
+    static std::int64_t unzigzag(std::uint64_t v){
+        return static_cast<std::int64_t>(v >> 1) ^ -static_cast<std::int64_t>(v & 1);
+    }
+
+    static void putVarint(unsigned char*& p, std::uint64_t v){
+        while(v >= 0x80){
+            *p++ = static_cast<unsigned char>(v | 0x80);
+            v >>= 7;
+        }
+        *p++ = static_cast<unsigned char>(v);
+    }
+
+    static std::uint64_t getVarint(const unsigned char*& p){
+        std::uint64_t v = 0;
+        unsigned shift = 0;
+        while(*p & 0x80){
+            v |= static_cast<std::uint64_t>(*p++ & 0x7f) << shift;
+            shift += 7;
+        }
+        return v | (static_cast<std::uint64_t>(*p++) << shift);
+    }
+
+    void openBlock(std::int64_t time, std::uint64_t bits){
+        if(blocks.isFull()){
+            droppedCount += blocks.front().count;
+            sampleCount -= blocks.front().count;
+            blocks.dequeue();
+        }
+        block b;
+        b.firstTime = time;
+        b.firstBits = bits;
+        b.count = 1;
+        b.used = 0;
+        blocks.enqueue(b);
+        lastDelta = 0;
+    }
+
+public:
+    // forward iterator that decodes samples oldest-first; invalidated by append/clear
+    class const_iterator
+    {
+        friend class compressedRing;
+
+    private:
+        const circularQueue<block>* ring;
+        std::size_t blockIdx;
+        std::uint32_t left;             // samples left in the current block, this one included
+        const unsigned char* p;
+        std::int64_t time;
+        std::int64_t delta;
+        std::uint64_t bits;
+
+        const_iterator(const circularQueue<block>* ring, std::size_t blockIdx)
+            : ring(ring), blockIdx(blockIdx), left(0), p(nullptr), time(0), delta(0), bits(0){
+            load();
+        }
+
+        void load(){
+            if(blockIdx < ring->size()){
+                const block& b = (*ring)[blockIdx];
+                left = b.count;
+                p = b.bytes;
+                time = b.firstTime;
+                delta = 0;
+                bits = b.firstBits;
+            }
+            else{
+                left = 0;
+            }
+        }
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef sample value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const sample* pointer;
+        typedef sample reference;
+
+        sample operator*() const{
+            return sample{time, fromBits(bits)};
+        }
+
+        const_iterator& operator++(){
+            if(--left == 0){
+                blockIdx++;
+                load();
+                return *this;
+            }
+            delta += unzigzag(getVarint(p));
+            time += delta;
+            unsigned char c = *p++;
+            if(c != kUnchanged){
+                bits ^= getVarint(p) << (8 * c);
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int){
+            const_iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const const_iterator& other) const{
+            return blockIdx == other.blockIdx && left == other.left;
+        }
+
+        bool operator!=(const const_iterator& other) const{
+            return !(*this == other);
+        }
+    };
+
+    // ctor, keeps at most maxBlocks blocks of BlockBytes encoded bytes each
+    explicit compressedRing(std::size_t maxBlocks)
+        : blocks(static_cast<int>(maxBlocks)), sampleCount(0), droppedCount(0),
+          lastTime(0), lastDelta(0), lastBits(0){
+        if(maxBlocks == 0){
+            throw std::invalid_argument("compressedRing needs at least one block");
+        }
+    }
+
+    void append(std::int64_t time, const V& value){
+        std::uint64_t bits = toBits(value);
+        if(blocks.empty() || blocks[blocks.size() - 1].used + kMaxSampleBytes > BlockBytes){
+            openBlock(time, bits);
+        }
+        else{
+            block& b = blocks[blocks.size() - 1];
+            unsigned char* p = b.bytes + b.used;
+            std::int64_t delta = time - lastTime;
+            putVarint(p, zigzag(delta - lastDelta));
+            lastDelta = delta;
+
+            std::uint64_t x = bits ^ lastBits;
+            if(x == 0){
+                *p++ = kUnchanged;
+            }
+            else{
+                unsigned char tz = 0;
+                while((x & 0xff) == 0){
+                    x >>= 8;
+                    tz++;
+                }
+                *p++ = tz;
+                putVarint(p, x);
+            }
+            b.used = static_cast<std::uint32_t>(p - b.bytes);
+            b.count++;
+        }
+        lastTime = time;
+        lastBits = bits;
+        sampleCount++;
+    }
+
+    const_iterator begin() const{
+        return const_iterator(&blocks, 0);
+    }
+
+    const_iterator end() const{
+        return const_iterator(&blocks, blocks.size());
+    }
+
+    sample back() const{
+        if(sampleCount == 0){
+            throw std::runtime_error("Ring is empty");
+        }
+        return sample{lastTime, fromBits(lastBits)};
+    }
+
+    std::size_t size() const{
+        return sampleCount;
+    }
+
+    bool empty() const{
+        return sampleCount == 0;
+    }
+
+    // samples evicted together with their block
+    std::size_t dropped() const{
+        return droppedCount;
+    }
+
+    std::size_t blockCount() const{
+        return blocks.size();
+    }
+
+    // bytes reserved for the ring, whether or not the blocks are filled yet
+    std::size_t memoryBytes(){
+        return blocks.capacity() * sizeof(block);
+    }
+
+    // bytes currently holding samples (block headers included)
+    std::size_t encodedBytes() const{
+        std::size_t n = 0;
+        for(std::size_t i = 0; i < blocks.size(); i++){
+            n += sizeof(block) - BlockBytes + blocks[i].used;
+        }
+        return n;
+    }
+
+    void clear(){
+        blocks.clear();
+        sampleCount = 0;
+        lastDelta = 0;
+    }
+};
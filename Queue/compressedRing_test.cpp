@@ -0,0 +1,217 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <chrono>
+#include <random>
+#include <limits>
+#include <cstdint>
+
+// 包含你的compressed ring實現
+#include "compressedRing.cpp"
+
+// 測試計數器
+int tests_passed = 0;
+int tests_total = 0;
+
+// 測試輔助宏
+#define TEST(name) \
+    void test_##name(); \
+    void run_test_##name() { \
+        tests_total++; \
+        std::cout << "Testing " #name "... "; \
+        try { \
+            test_##name(); \
+            tests_passed++; \
+            std::cout << "PASSED\n"; \
+        } catch (const std::exception& e) { \
+            std::cout << "FAILED: " << e.what() << "\n"; \
+        } catch (...) { \
+            std::cout << "FAILED: Unknown exception\n"; \
+        } \
+    } \
+    void test_##name()
+
+typedef std::pair<std::int64_t, std::int64_t> rawSample;
+
+template <typename Ring>
+std::vector<rawSample> decodeAll(const Ring& r) {
+    std::vector<rawSample> out;
+    for (auto it = r.begin(); it != r.end(); ++it) out.push_back({(*it).time, (*it).value});
+    return out;
+}
+
+// ============= 基本功能測試 =============
+
+TEST(empty_ring) {
+    compressedRing<> r(4);
+    assert(r.empty() && r.size() == 0);
+    assert(r.begin() == r.end());
+    try {
+        r.back();
+        assert(false);
+    } catch (const std::runtime_error&) {
+        // 預期的異常
+    }
+    try {
+        compressedRing<> bad(0);
+        assert(false);
+    } catch (const std::invalid_argument&) {
+        // 預期的異常
+    }
+}
+
+TEST(round_trip_regular_series) {
+    compressedRing<> r(64);
+    std::vector<rawSample> expected;
+    std::int64_t value = 1000;
+    for (int i = 0; i < 2000; i++) {
+        std::int64_t t = 1700000000 + i;  // 每秒一個樣本
+        value += (i % 7) - 3;
+        r.append(t, value);
+        expected.push_back({t, value});
+    }
+    assert(r.size() == 2000);
+    assert(r.dropped() == 0);
+    assert(decodeAll(r) == expected);
+    assert(r.back().time == expected.back().first && r.back().value == expected.back().second);
+
+    // 規律的序列每個樣本只需要約2到3個byte
+    double perSample = double(r.encodedBytes()) / r.size();
+    assert(perSample < 4.0);
+}
+
+TEST(round_trip_extremes) {
+    // 亂序時間戳、極端值、大幅跳動
+    std::mt19937_64 rng(5);
+    compressedRing<std::int64_t, 64> r(100000);
+    std::vector<rawSample> expected;
+    const std::int64_t specials[] = {0, -1, std::numeric_limits<std::int64_t>::max(),
+                                     std::numeric_limits<std::int64_t>::min(), 1LL << 40};
+    std::int64_t t = 0;
+    for (int i = 0; i < 50000; i++) {
+        t += static_cast<std::int64_t>(rng() % 2000001) - 1000000;
+        std::int64_t v = (i % 10 == 0) ? specials[(i / 10) % 5] : static_cast<std::int64_t>(rng());
+        r.append(t, v);
+        expected.push_back({t, v});
+    }
+    assert(decodeAll(r) == expected);
+}
+
+TEST(double_values) {
+    compressedRing<double> r(16);
+    std::vector<std::pair<std::int64_t, double>> expected;
+    double v = 20.5;
+    for (int i = 0; i < 500; i++) {
+        if (i % 5 == 0) v += 0.25;  // 溫度之類的量測值常常保持不變
+        r.append(i * 10, v);
+        expected.push_back({i * 10, v});
+    }
+    std::size_t i = 0;
+    for (auto it = r.begin(); it != r.end(); it++, i++) {
+        assert((*it).time == expected[i].first);
+        assert((*it).value == expected[i].second);  // 必須逐位元相同
+    }
+    assert(i == expected.size());
+}
+
+TEST(eviction_drops_whole_block) {
+    compressedRing<std::int64_t, 32> r(3);
+    std::int64_t n = 0;
+    while (r.dropped() == 0) {
+        r.append(n, n);
+        n++;
+    }
+    assert(r.blockCount() == 3);
+
+    // 一次丟掉整個block
+    std::size_t dropped = r.dropped();
+    assert(dropped > 1);
+    assert(r.size() == std::size_t(n) - dropped);
+    auto all = decodeAll(r);
+    assert(all.size() == r.size());
+    assert(all.front().first == std::int64_t(dropped));
+    assert(all.back().first == n - 1);
+
+    r.clear();
+    assert(r.empty() && r.begin() == r.end());
+    r.append(5, 6);
+    assert(decodeAll(r) == (std::vector<rawSample>{{5, 6}}));
+}
+
+// ============= 性能測試 =============
+
+TEST(bytes_per_sample_and_decode_speed) {
+    // 一天每秒一個樣本，偶爾有抖動
+    const int N = 86400 * 20;
+    std::mt19937 rng(11);
+    std::vector<rawSample> series(N);
+    std::int64_t t = 1700000000, v = 500;
+    for (int i = 0; i < N; i++) {
+        t += (rng() % 50 == 0) ? 2 : 1;
+        v += static_cast<std::int64_t>(rng() % 21) - 10;
+        series[i] = {t, v};
+    }
+
+    circularQueue<rawSample> raw(N);
+    compressedRing<std::int64_t, 256> packed(N / 64);
+    for (auto& s : series) {
+        raw.enqueue(s);
+        packed.append(s.first, s.second);
+    }
+    assert(packed.dropped() == 0);
+
+    auto t0 = std::chrono::steady_clock::now();
+    long long sumRaw = 0;
+    for (int rep = 0; rep < 5; rep++) {
+        auto spans = raw.readable_spans();
+        for (std::size_t i = 0; i < spans.first.len; i++) sumRaw += spans.first.ptr[i].first ^ spans.first.ptr[i].second;
+        for (std::size_t i = 0; i < spans.second.len; i++) sumRaw += spans.second.ptr[i].first ^ spans.second.ptr[i].second;
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    long long sumPacked = 0;
+    for (int rep = 0; rep < 5; rep++) {
+        for (auto it = packed.begin(); it != packed.end(); ++it) {
+            auto s = *it;
+            sumPacked += s.time ^ s.value;
+        }
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    assert(sumRaw == sumPacked);
+
+    auto rate = [&](std::chrono::steady_clock::time_point a, std::chrono::steady_clock::time_point b) {
+        double s = std::chrono::duration<double>(b - a).count();
+        return 5.0 * N / s / 1e6;
+    };
+    std::cout << "\n  raw ring: " << sizeof(rawSample) << " bytes/sample, " << rate(t0, t1) << "M samples/s"
+              << "\n  compressed: " << double(packed.encodedBytes()) / packed.size() << " bytes/sample, "
+              << rate(t1, t2) << "M samples/s decode ";
+}
+
+// ============= 主測試函數 =============
+
+int main() {
+    std::cout << "=== CompressedRing 測試套件 ===\n\n";
+
+    // 運行所有測試
+    run_test_empty_ring();
+    run_test_round_trip_regular_series();
+    run_test_round_trip_extremes();
+    run_test_double_values();
+    run_test_eviction_drops_whole_block();
+    run_test_bytes_per_sample_and_decode_speed();
+
+    // 測試結果
+    std::cout << "\n=== 測試結果 ===\n";
+    std::cout << "通過: " << tests_passed << "/" << tests_total << " 測試\n";
+
+    if (tests_passed == tests_total) {
+        std::cout << "🎉 所有測試通過！\n";
+        return 0;
+    } else {
+        std::cout << "❌ 有 " << (tests_total - tests_passed) << " 個測試失敗\n";
+        return 1;
+    }
+}
@@ -0,0 +1,159 @@
+#include <iostream>
+#include <utility>
+#include <stdexcept>
+#include <functional>
+#include <unordered_map>
+#include <cstdint>
+
+#include "queue.cpp"
+
+// value type for a dedupQueue that only carries keys
+struct dedupNone{};
+
+// FIFO of work keys in which a key that is already waiting is not queued again.
+//
+// Pending entries live in an unordered_map<K, V>; the FIFO order is a queue of pointers
+// to the map's nodes (node addresses survive rehashing). Enqueueing a pending key is a
+// single hash lookup: by default the pending entry is kept as is, or a merge callback
+// folds the new value into it, and the key keeps its original place in line. Once a
+// key is dequeued it is no longer pending, so enqueueing it while it is being processed
+// schedules it again - what an invalidation worker wants.
+template <typename K, typename V = dedupNone, typename Hash = std::hash<K>>
+class dedupQueue
+{
+public:
+    typedef std::function<void(V& pending, const V& incoming)> mergeFn;
+
+private:
+    typedef std::unordered_map<K, V, Hash> index;
+
+    index pending;
+    ::queue<typename index::value_type*> order;
+    mergeFn merge;
+    std::uint64_t enqueuedCount = 0;
+    std::uint64_t coalescedCount = 0;
+
+    void checkNotEmpty() const{
+        if(order.empty()){
+            throw std::underflow_error("dedupQueue is empty");
+        }
+    }
+
+public:
+    // ctor
+    explicit dedupQueue(std::size_t cap = 16, mergeFn merge = nullptr) : order(cap), merge(std::move(merge)){
+        pending.reserve(cap);
+    }
+
+    // copying would leave order pointing into the other queue's map
+    dedupQueue(const dedupQueue&) = delete;
+    dedupQueue& operator=(const dedupQueue&) = delete;
+
+    // move ctor: unordered_map keeps its nodes when moved, so order stays valid
+    dedupQueue(dedupQueue&& other) noexcept
+    : pending(std::move(other.pending)),
+      order(std::move(other.order)),
+      merge(std::move(other.merge)),
+      enqueuedCount(std::exchange(other.enqueuedCount, 0)),
+      coalescedCount(std::exchange(other.coalescedCount, 0)){}
+
+    // move assignment
+    dedupQueue& operator=(dedupQueue&& other) noexcept{
+        dedupQueue tmp(std::move(other));
+        swap(tmp);
+        return *this;
+    }
+
+    // swapping the maps keeps their nodes, so both orders stay valid
+    void swap(dedupQueue& other) noexcept{
+        std::swap(pending, other.pending);
+        order.swap(other.order);
+        std::swap(merge, other.merge);
+        std::swap(enqueuedCount, other.enqueuedCount);
+        std::swap(coalescedCount, other.coalescedCount);
+    }
+
+    // true if key was queued, false if it coalesced into the pending entry
+    bool enqueue(const K& key, const V& value = V()){
+        enqueuedCount++;
+        auto found = pending.find(key);
+        if(found != pending.end()){
+            coalescedCount++;
+            if(merge){
+                merge(found->second, value);
+            }
+            return false;
+        }
+        auto inserted = pending.emplace(key, value).first;
+        try
+        {
+            order.enqueue(&*inserted);
+        }
+        catch(...)
+        {
+            pending.erase(inserted);
+            enqueuedCount--;
+            throw;
+        }
+        return true;
+    }
+
+    const K& front() const{
+        checkNotEmpty();
+        return order.front()->first;
+    }
+
+    // the pending value, including everything merged into it so far
+    const V& frontValue() const{
+        checkNotEmpty();
+        return order.front()->second;
+    }
+
+    void dequeue(){
+        checkNotEmpty();
+        typename index::value_type* entry = order.front();
+        order.dequeue();
+        pending.erase(pending.find(entry->first));   // not erase(key): key lives in the node
+    }
+
+    bool contains(const K& key) const{
+        return pending.count(key) != 0;
+    }
+
+    bool empty() const{
+        return order.empty();
+    }
+
+    std::size_t size() const{
+        return order.size();
+    }
+
+    void clear(){
+        order.clear();
+        pending.clear();
+    }
+
+    // enqueue calls, including the coalesced ones
+    std::uint64_t enqueued() const{
+        return enqueuedCount;
+    }
+
+    // enqueue calls absorbed by an already pending key
+    std::uint64_t coalesced() const{
+        return coalescedCount;
+    }
+
+    // share of enqueues that did not create work
+    double coalesceRatio() const{
+        return enqueuedCount == 0 ? 0.0 : static_cast<double>(coalescedCount) / enqueuedCount;
+    }
+
+    void resetCounters(){
+        enqueuedCount = coalescedCount = 0;
+    }
+
+    void print() const{
+        std::cout << "dedupQueue: " << order.size() << " pending, " << enqueuedCount << " enqueued, "
+                  << coalescedCount << " coalesced (" << coalesceRatio() * 100 << "%)\n";
+    }
+};
@@ -0,0 +1,255 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <cstdint>
+
+// 包含你的dedupQueue實現
+#include "dedupQueue.cpp"
+
+// 測試計數器
+int tests_passed = 0;
+int tests_total = 0;
+
+// 測試輔助宏
+#define TEST(name) \
+    void test_##name(); \
+    void run_test_##name() { \
+        tests_total++; \
+        std::cout << "Testing " #name "... "; \
+        try { \
+            test_##name(); \
+            tests_passed++; \
+            std::cout << "PASSED\n"; \
+        } catch (const std::exception& e) { \
+            std::cout << "FAILED: " << e.what() << "\n"; \
+        } catch (...) { \
+            std::cout << "FAILED: Unknown exception\n"; \
+        } \
+    } \
+    void test_##name()
+
+// ============= 基本功能測試 =============
+
+TEST(duplicates_keep_first_position) {
+    dedupQueue<std::string> q;
+    assert(q.enqueue("a"));
+    assert(q.enqueue("b"));
+    assert(!q.enqueue("a"));  // 已經在排隊
+    assert(q.enqueue("c"));
+    assert(!q.enqueue("b"));
+    assert(q.size() == 3 && q.contains("a") && !q.contains("d"));
+
+    std::vector<std::string> order;
+    while (!q.empty()) {
+        order.push_back(q.front());
+        q.dequeue();
+    }
+    assert((order == std::vector<std::string>{"a", "b", "c"}));
+    assert(q.enqueued() == 5 && q.coalesced() == 2);
+    assert(q.coalesceRatio() == 0.4);
+}
+
+TEST(requeue_after_dequeue) {
+    dedupQueue<int> q;
+    q.enqueue(1);
+    q.enqueue(2);
+    assert(q.front() == 1);
+    q.dequeue();              // 1 正在處理
+    assert(q.enqueue(1));     // 處理中又失效，要重新排隊
+    assert(!q.enqueue(2));
+    assert(q.front() == 2);
+    q.dequeue();
+    assert(q.front() == 1);
+    q.dequeue();
+    assert(q.empty() && !q.contains(1));
+}
+
+TEST(merge_callback) {
+    // 合併：累加計數並保留最新的版本號
+    struct change {
+        int count;
+        int version;
+    };
+    dedupQueue<std::string, change> q(4, [](change& pending, const change& incoming) {
+        pending.count += incoming.count;
+        pending.version = std::max(pending.version, incoming.version);
+    });
+    q.enqueue("user:1", {1, 3});
+    q.enqueue("user:2", {1, 1});
+    q.enqueue("user:1", {2, 7});
+    q.enqueue("user:1", {1, 5});
+    assert(q.size() == 2);
+    assert(q.front() == "user:1");
+    assert(q.frontValue().count == 4 && q.frontValue().version == 7);
+    q.dequeue();
+    assert(q.frontValue().count == 1);
+
+    // 沒有callback時保留原本的值
+    dedupQueue<int, int> keep;
+    keep.enqueue(5, 10);
+    keep.enqueue(5, 20);
+    assert(keep.frontValue() == 10);
+}
+
+TEST(growth_and_move) {
+    dedupQueue<int, int> q(2);  // 大量擴容、rehash之後指標仍然有效
+    for (int i = 0; i < 100000; i++) q.enqueue(i % 50000, i);
+    assert(q.size() == 50000 && q.coalesced() == 50000);
+
+    dedupQueue<int, int> moved(std::move(q));
+    for (int i = 0; i < 50000; i++) {
+        assert(moved.front() == i && moved.frontValue() == i);
+        moved.dequeue();
+    }
+    assert(moved.empty());
+
+    moved.enqueue(7);
+    moved.clear();
+    assert(moved.empty() && !moved.contains(7));
+    assert(moved.enqueue(7));
+
+    // move assignment：原本的內容被換掉，指標仍然指向正確的map
+    dedupQueue<int, int> target;
+    target.enqueue(5000, 1);
+    for (int i = 0; i < 1000; i++) q.enqueue(i, -i);  // q被move過，可以重新使用
+    target = std::move(q);
+    assert(target.size() == 1000 && !target.contains(5000) && target.enqueued() == 1000);
+    for (int i = 0; i < 1000; i++) {
+        assert(target.front() == i && target.frontValue() == -i);
+        target.dequeue();
+    }
+    assert(target.empty() && target.enqueue(7));
+}
+
+TEST(empty_queue_exceptions) {
+    dedupQueue<int> q;
+    try {
+        q.front();
+        assert(false);
+    } catch (const std::underflow_error&) {
+        // 預期的異常
+    }
+    try {
+        q.dequeue();
+        assert(false);
+    } catch (const std::underflow_error&) {
+        // 預期的異常
+    }
+    assert(q.coalesceRatio() == 0.0);
+}
+
+// ============= 性能測試 =============
+
+// 輔助：Zipf(s)分布的key，預先算好CDF再二分搜尋
+class zipf {
+    std::vector<double> cdf;
+    std::mt19937_64 rng;
+    std::uniform_real_distribution<double> u{0.0, 1.0};
+
+public:
+    zipf(std::size_t n, double s, std::uint64_t seed) : cdf(n), rng(seed) {
+        double sum = 0;
+        for (std::size_t i = 0; i < n; i++) {
+            sum += 1.0 / std::pow(i + 1, s);
+            cdf[i] = sum;
+        }
+        for (double& c : cdf) c /= sum;
+    }
+
+    int next() { return static_cast<int>(std::lower_bound(cdf.begin(), cdf.end(), u(rng)) - cdf.begin()); }
+};
+
+// 輔助函數：每個key的「失效處理」工作量
+static std::uint64_t invalidate(std::uint64_t x) {
+    for (int i = 0; i < 200; i++) {
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 31;
+    }
+    return x;
+}
+
+TEST(zipf_invalidation_stream) {
+    const int N = 2000000, BURST = 64;  // 每來64個key，worker處理16個
+    std::vector<int> keys;
+    keys.reserve(N);
+    zipf z(100000, 1.1, 42);
+    for (int i = 0; i < N; i++) keys.push_back(z.next());
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::uint64_t plainSum = 0, plainWork = 0;
+    ::queue<int> plain(1024);
+    for (int i = 0; i < N; i++) {
+        plain.enqueue(keys[i]);
+        if (i % BURST == BURST - 1) {
+            for (int j = 0; j < BURST / 4 && !plain.empty(); j++, plainWork++) {
+                plainSum += invalidate(plain.front());
+                plain.dequeue();
+            }
+        }
+    }
+    for (; !plain.empty(); plainWork++) {
+        plainSum += invalidate(plain.front());
+        plain.dequeue();
+    }
+    auto t1 = std::chrono::steady_clock::now();
+
+    std::uint64_t dedupSum = 0, dedupWork = 0;
+    dedupQueue<int> q(1024);
+    for (int i = 0; i < N; i++) {
+        q.enqueue(keys[i]);
+        if (i % BURST == BURST - 1) {
+            for (int j = 0; j < BURST / 4 && !q.empty(); j++, dedupWork++) {
+                dedupSum += invalidate(q.front());
+                q.dequeue();
+            }
+        }
+    }
+    for (; !q.empty(); dedupWork++) {
+        dedupSum += invalidate(q.front());
+        q.dequeue();
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    assert(plainWork == static_cast<std::uint64_t>(N) && plainSum != 0 && dedupSum != 0);
+    assert(dedupWork == q.enqueued() - q.coalesced());
+    assert(q.coalesceRatio() > 0.5);  // 高度偏斜時絕大多數重複
+
+    std::cout << "\n  " << N << " zipf(1.1) keys over 100k: plain queue " << plainWork << " invalidations in "
+              << std::chrono::duration<double, std::milli>(t1 - t0).count() << "ms; dedupQueue " << dedupWork
+              << " in " << std::chrono::duration<double, std::milli>(t2 - t1).count() << "ms, coalesce ratio "
+              << q.coalesceRatio() << " ";
+}
+
+// ============= 主測試函數 =============
+
+int main() {
+    std::cout << "=== DedupQueue 測試套件 ===\n\n";
+
+    // 運行所有測試
+    run_test_duplicates_keep_first_position();
+    run_test_requeue_after_dequeue();
+    run_test_merge_callback();
+    run_test_growth_and_move();
+    run_test_empty_queue_exceptions();
+    run_test_zipf_invalidation_stream();
+
+    // 測試結果
+    std::cout << "\n=== 測試結果 ===\n";
+    std::cout << "通過: " << tests_passed << "/" << tests_total << " 測試\n";
+
+    if (tests_passed == tests_total) {
+        std::cout << "🎉 所有測試通過！\n";
+        return 0;
+    } else {
+        std::cout << "❌ 有 " << (tests_total - tests_passed) << " 個測試失敗\n";
+        return 1;
+    }
+}
@@ -0,0 +1,228 @@
+#include <iostream>
+#include <utility>
+#include <stdexcept>
+#include <vector>
+#include <cstdint>
+
+#include "queue.cpp"
+
+// What enqueue does when a tenant is already at its depth limit.
+enum class dropPolicy { reject, dropNewest, dropOldest };
+
+// Multi-tenant FIFO with deficit round robin (Shreedhar & Varghese) across tenants.
+//
+// Every tenant owns a queue<T>. Tenants that hold at least one item sit on an active
+// list, itself a queue<std::uint32_t> used as a rotating FIFO; idle tenants are not on
+// it, so dequeue never looks at them. When the tenant at the head of the list starts
+// its turn it earns quantum * weight credit; it is served while the credit covers the
+// cost of its next item, then goes to the back of the list (or leaves the list when it
+// runs dry, losing the rest of its credit). Over time each backlogged tenant gets a
+// share of the cost served proportional to its weight, however much the others queue.
+//
+// enqueue / dequeue are O(1) amortised as long as quantum * weight >= the largest item
+// cost (with unit costs, always); otherwise a dequeue may rotate past tenants that are
+// still saving up.
+template <typename T>
+class fairQueue
+{
+private:
+    struct item{
+        T value;
+        std::uint32_t cost;
+    };
+
+    struct tenant{
+        ::queue<item> items;
+        std::uint32_t weight;
+        std::size_t maxDepth;       // 0 = unlimited
+        dropPolicy policy;
+        std::uint64_t deficit = 0;
+        std::uint64_t served = 0;   // cost dequeued
+        std::size_t dropped = 0;
+        bool active = false;
+
+        tenant(std::uint32_t weight, std::size_t maxDepth, dropPolicy policy)
+        : items(4), weight(weight), maxDepth(maxDepth), policy(policy){}
+    };
+
+    std::vector<tenant> tenants;
+    ::queue<std::uint32_t> activeList;
+    std::uint32_t quantum;
+    bool inTurn = false;            // head of activeList has been credited for this turn
+    std::size_t count = 0;
+
+    tenant& at(std::size_t id){
+        if(id >= tenants.size()){
+            throw std::invalid_argument("fairQueue: unknown tenant");
+        }
+        return tenants[id];
+    }
+
+    const tenant& at(std::size_t id) const{
+        if(id >= tenants.size()){
+            throw std::invalid_argument("fairQueue: unknown tenant");
+        }
+        return tenants[id];
+    }
+
+    // room for one more item in t, applying its drop policy; false if the new item is dropped
+    bool admit(tenant& t){
+        if(t.maxDepth == 0 || t.items.size() < t.maxDepth){
+            return true;
+        }
+        switch(t.policy){
+            case dropPolicy::reject:
+                throw std::overflow_error("fairQueue: tenant is full");
+            case dropPolicy::dropNewest:
+                t.dropped++;
+                return false;
+            case dropPolicy::dropOldest:
+                t.items.dequeue();
+                t.dropped++;
+                count--;
+                return true;
+        }
+        return false;
+    }
+
+    // advance the round until the head tenant can afford its next item
+    tenant& headWithCredit(){
+        while(true){
+            tenant& t = tenants[activeList.front()];
+            if(!inTurn){
+                t.deficit += std::uint64_t(quantum) * t.weight;
+                inTurn = true;
+            }
+            if(t.items.front().cost <= t.deficit){
+                return t;
+            }
+            // turn over, keep the unspent credit for the next round
+            std::uint32_t id = activeList.front();   // copy: enqueue may move the buffer
+            activeList.dequeue();
+            activeList.enqueue(id);
+            inTurn = false;
+        }
+    }
+
+public:
+    // ctor
+    explicit fairQueue(std::uint32_t quantum = 1) : activeList(16), quantum(quantum){
+        if(quantum == 0){
+            throw std::invalid_argument("fairQueue: quantum must be positive");
+        }
+    }
+
+    // returns the new tenant's id, ids are dense from 0
+    std::size_t addTenant(std::uint32_t weight = 1, std::size_t maxDepth = 0,
+                          dropPolicy policy = dropPolicy::reject){
+        if(weight == 0){
+            throw std::invalid_argument("fairQueue: weight must be positive");
+        }
+        if(tenants.size() >= 0xffffffffu){
+            throw std::length_error("fairQueue: too many tenants");
+        }
+        tenants.emplace_back(weight, maxDepth, policy);
+        return tenants.size() - 1;
+    }
+
+    // takes effect from the tenant's next turn
+    void setWeight(std::size_t id, std::uint32_t weight){
+        if(weight == 0){
+            throw std::invalid_argument("fairQueue: weight must be positive");
+        }
+        at(id).weight = weight;
+    }
+
+    // false if the item was dropped by dropNewest; throws overflow_error under reject
+    bool enqueue(std::size_t id, const T& value, std::uint32_t cost = 1){
+        tenant& t = at(id);
+        if(!admit(t)){
+            return false;
+        }
+        t.items.enqueue(item{value, cost});
+        count++;
+        if(!t.active){
+            t.active = true;
+            activeList.enqueue(static_cast<std::uint32_t>(id));
+        }
+        return true;
+    }
+
+    // the item the next dequeue() will return
+    const T& front(){
+        if(count == 0){
+            throw std::underflow_error("fairQueue is empty");
+        }
+        return headWithCredit().items.front().value;
+    }
+
+    // tenant the next dequeue() will serve
+    std::size_t frontTenant(){
+        if(count == 0){
+            throw std::underflow_error("fairQueue is empty");
+        }
+        headWithCredit();
+        return activeList.front();
+    }
+
+    void dequeue(){
+        if(count == 0){
+            throw std::underflow_error("fairQueue is empty");
+        }
+        tenant& t = headWithCredit();
+        std::uint32_t cost = t.items.front().cost;
+        t.items.dequeue();
+        t.deficit -= cost;
+        t.served += cost;
+        count--;
+        if(t.items.empty()){
+            // an idle tenant does not bank credit
+            t.deficit = 0;
+            t.active = false;
+            activeList.dequeue();
+            inTurn = false;
+        }
+    }
+
+    bool empty() const{
+        return count == 0;
+    }
+
+    std::size_t size() const{
+        return count;
+    }
+
+    std::size_t tenantCount() const{
+        return tenants.size();
+    }
+
+    std::size_t activeTenants() const{
+        return activeList.size();
+    }
+
+    std::size_t depth(std::size_t id) const{
+        return at(id).items.size();
+    }
+
+    // total cost dequeued for this tenant
+    std::uint64_t served(std::size_t id) const{
+        return at(id).served;
+    }
+
+    // items lost to dropNewest / dropOldest
+    std::size_t dropped(std::size_t id) const{
+        return at(id).dropped;
+    }
+
+    void print() const{
+        std::cout << "fairQueue: " << count << " items, " << activeList.size() << "/" << tenants.size()
+                  << " tenants active\n";
+        for(std::size_t i = 0; i < tenants.size(); i++){
+            const tenant& t = tenants[i];
+            if(t.active || t.dropped != 0){
+                std::cout << "  tenant " << i << " (weight " << t.weight << "): depth " << t.items.size()
+                          << ", served " << t.served << ", dropped " << t.dropped << "\n";
+            }
+        }
+    }
+};
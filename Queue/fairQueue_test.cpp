@@ -0,0 +1,279 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <chrono>
+#include <cstdint>
+
+// 包含你的fairQueue實現
+#include "fairQueue.cpp"
+
+// 測試計數器
+int tests_passed = 0;
+int tests_total = 0;
+
+// 測試輔助宏
+#define TEST(name) \
+    void test_##name(); \
+    void run_test_##name() { \
+        tests_total++; \
+        std::cout << "Testing " #name "... "; \
+        try { \
+            test_##name(); \
+            tests_passed++; \
+            std::cout << "PASSED\n"; \
+        } catch (const std::exception& e) { \
+            std::cout << "FAILED: " << e.what() << "\n"; \
+        } catch (...) { \
+            std::cout << "FAILED: Unknown exception\n"; \
+        } \
+    } \
+    void test_##name()
+
+// ============= 基本功能測試 =============
+
+TEST(round_robin_fifo_per_tenant) {
+    fairQueue<std::string> q;
+    std::size_t a = q.addTenant(), b = q.addTenant(), c = q.addTenant();
+    q.enqueue(a, "a1");
+    q.enqueue(a, "a2");
+    q.enqueue(a, "a3");
+    q.enqueue(b, "b1");
+    q.enqueue(c, "c1");
+    q.enqueue(c, "c2");
+    assert(q.size() == 6 && q.activeTenants() == 3);
+
+    std::vector<std::string> order;
+    while (!q.empty()) {
+        order.push_back(q.front());
+        q.dequeue();
+    }
+    assert((order == std::vector<std::string>{"a1", "b1", "c1", "a2", "c2", "a3"}));
+    assert(q.activeTenants() == 0);
+    assert(q.served(a) == 3 && q.served(b) == 1);
+
+    // 閒置之後再回來，排到隊尾
+    q.enqueue(c, "c3");
+    q.enqueue(a, "a4");
+    assert(q.frontTenant() == c);
+    q.dequeue();
+    assert(q.front() == "a4");
+}
+
+TEST(weights_set_the_share) {
+    fairQueue<int> q;
+    std::size_t t[3];
+    for (int i = 0; i < 3; i++) {
+        t[i] = q.addTenant(i + 1);  // 權重 1 : 2 : 3
+        for (int j = 0; j < 6000; j++) q.enqueue(t[i], j);
+    }
+    for (int i = 0; i < 600; i++) q.dequeue();
+    assert(q.served(t[0]) == 100 && q.served(t[1]) == 200 && q.served(t[2]) == 300);
+
+    q.setWeight(t[0], 3);  // 下一輪開始生效
+    for (int i = 0; i < 600; i++) q.dequeue();
+    assert(q.served(t[0]) + q.served(t[1]) + q.served(t[2]) == 1200);
+    assert(q.served(t[0]) >= 100 + 200 && q.served(t[1]) <= 200 + 150);
+}
+
+TEST(deficit_tracks_item_cost) {
+    fairQueue<int> q(100);  // 每輪每單位權重100的額度
+    std::size_t big = q.addTenant(), small = q.addTenant();
+    for (int i = 0; i < 100; i++) {
+        q.enqueue(big, i, 100);
+        q.enqueue(small, i, 50);
+        q.enqueue(small, i, 50);
+    }
+    std::size_t bigItems = 0, smallItems = 0;
+    for (int i = 0; i < 150; i++) {
+        (q.frontTenant() == big ? bigItems : smallItems)++;
+        q.dequeue();
+    }
+    assert(bigItems == 50 && smallItems == 100);  // 成本相同，件數差一倍
+    assert(q.served(big) == q.served(small));
+
+    // 額度不夠時要存到下一輪
+    fairQueue<int> slow(10);
+    std::size_t heavy = slow.addTenant(), light = slow.addTenant();
+    slow.enqueue(heavy, 1, 25);
+    slow.enqueue(light, 2, 10);
+    slow.enqueue(light, 3, 10);
+    slow.enqueue(light, 4, 10);
+    std::vector<int> order;
+    while (!slow.empty()) {
+        order.push_back(slow.front());
+        slow.dequeue();
+    }
+    assert((order == std::vector<int>{2, 3, 1, 4}));  // heavy第三輪才付得起25
+}
+
+TEST(idle_tenants_are_skipped) {
+    fairQueue<int> q;
+    for (int i = 0; i < 10000; i++) q.addTenant();
+    q.enqueue(9999, 1);
+    q.enqueue(17, 2);
+    q.enqueue(9999, 3);
+    assert(q.tenantCount() == 10000 && q.activeTenants() == 2);
+    assert(q.frontTenant() == 9999);
+    q.dequeue();
+    assert(q.frontTenant() == 17);
+    q.dequeue();
+    assert(q.front() == 3 && q.activeTenants() == 1);
+    q.dequeue();
+    assert(q.empty() && q.activeTenants() == 0);
+}
+
+TEST(noisy_tenant_cannot_starve_others) {
+    fairQueue<int> q;
+    std::size_t noisy = q.addTenant();
+    for (int i = 0; i < 100000; i++) q.enqueue(noisy, i);
+    std::vector<std::size_t> quiet;
+    for (int i = 0; i < 50; i++) {
+        quiet.push_back(q.addTenant());
+        for (int j = 0; j < 10; j++) q.enqueue(quiet.back(), j);
+    }
+    // 每一輪noisy只拿到1件，所以 11 * 50 次之內其他人都清空
+    for (int i = 0; i < 10 * 51; i++) q.dequeue();
+    for (std::size_t t : quiet) assert(q.depth(t) == 0);
+    assert(q.served(noisy) == 10);
+}
+
+TEST(drop_policies) {
+    fairQueue<int> q;
+    std::size_t rej = q.addTenant(1, 2, dropPolicy::reject);
+    std::size_t newest = q.addTenant(1, 2, dropPolicy::dropNewest);
+    std::size_t oldest = q.addTenant(1, 2, dropPolicy::dropOldest);
+
+    q.enqueue(rej, 1);
+    q.enqueue(rej, 2);
+    try {
+        q.enqueue(rej, 3);
+        assert(false);
+    } catch (const std::overflow_error&) {
+        // 預期的異常
+    }
+
+    assert(q.enqueue(newest, 1) && q.enqueue(newest, 2));
+    assert(!q.enqueue(newest, 3));
+    assert(q.dropped(newest) == 1 && q.depth(newest) == 2);
+
+    for (int i = 1; i <= 5; i++) assert(q.enqueue(oldest, i));
+    assert(q.dropped(oldest) == 3 && q.depth(oldest) == 2);
+    assert(q.size() == 6);
+
+    std::vector<int> fromOldest;
+    while (!q.empty()) {
+        if (q.frontTenant() == oldest) fromOldest.push_back(q.front());
+        q.dequeue();
+    }
+    assert((fromOldest == std::vector<int>{4, 5}));  // 留下最新的兩個
+}
+
+TEST(invalid_arguments) {
+    fairQueue<int> q;
+    try {
+        q.dequeue();
+        assert(false);
+    } catch (const std::underflow_error&) {
+        // 預期的異常
+    }
+    try {
+        q.front();
+        assert(false);
+    } catch (const std::underflow_error&) {
+        // 預期的異常
+    }
+    try {
+        q.enqueue(0, 1);
+        assert(false);
+    } catch (const std::invalid_argument&) {
+        // 預期的異常
+    }
+    try {
+        q.addTenant(0);
+        assert(false);
+    } catch (const std::invalid_argument&) {
+        // 預期的異常
+    }
+    try {
+        fairQueue<int> bad(0);
+        assert(false);
+    } catch (const std::invalid_argument&) {
+        // 預期的異常
+    }
+}
+
+// ============= 性能測試 =============
+
+// 每次dequeue之後把一件補回同一個tenant，活躍tenant數維持不變
+static double steadyState(std::size_t tenants, std::size_t active, int ops, long long& sum) {
+    fairQueue<int> q;
+    for (std::size_t i = 0; i < tenants; i++) q.addTenant(1 + i % 4);
+    std::size_t stride = tenants / active;
+    for (std::size_t i = 0; i < active; i++) {
+        for (int j = 0; j < 8; j++) q.enqueue(i * stride, j);
+    }
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < ops; i++) {
+        std::size_t t = q.frontTenant();
+        sum += q.front();
+        q.dequeue();
+        q.enqueue(t, i);
+    }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / ops;
+}
+
+TEST(dequeue_cost_10k_tenants) {
+    const int OPS = 5000000;
+    long long a = 0, b = 0, c = 0, d = 0;
+    steadyState(10000, 10000, OPS / 10, a);  // 預熱
+
+    auto t0 = std::chrono::steady_clock::now();
+    ::queue<int> fifo(16);
+    for (int j = 0; j < 8; j++) fifo.enqueue(j);
+    for (int i = 0; i < OPS; i++) {
+        d += fifo.front();
+        fifo.dequeue();
+        fifo.enqueue(i);
+    }
+    double plain = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / OPS;
+
+    double all = steadyState(10000, 10000, OPS, a);
+    double sparse = steadyState(10000, 100, OPS, b);
+    double one = steadyState(10000, 1, OPS, c);
+    assert(a > 0 && b > 0 && c > 0 && d > 0);
+
+    std::cout << "\n  single queue<int> " << plain << " ns/op"
+              << "\n  10k tenants, all active " << all << " ns/op, 100 active " << sparse << " ns/op, 1 active "
+              << one << " ns/op ";
+}
+
+// ============= 主測試函數 =============
+
+int main() {
+    std::cout << "=== FairQueue 測試套件 ===\n\n";
+
+    // 運行所有測試
+    run_test_round_robin_fifo_per_tenant();
+    run_test_weights_set_the_share();
+    run_test_deficit_tracks_item_cost();
+    run_test_idle_tenants_are_skipped();
+    run_test_noisy_tenant_cannot_starve_others();
+    run_test_drop_policies();
+    run_test_invalid_arguments();
+    run_test_dequeue_cost_10k_tenants();
+
+    // 測試結果
+    std::cout << "\n=== 測試結果 ===\n";
+    std::cout << "通過: " << tests_passed << "/" << tests_total << " 測試\n";
+
+    if (tests_passed == tests_total) {
+        std::cout << "🎉 所有測試通過！\n";
+        return 0;
+    } else {
+        std::cout << "❌ 有 " << (tests_total - tests_passed) << " 個測試失敗\n";
+        return 1;
+    }
+}
@@ -0,0 +1,367 @@
+#include <iostream>
+#include <utility>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <string>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <cstdint>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Durable FIFO of fixed-size records: a circularQueue whose slots and header live in an
+// mmap'ed file, so the contents survive a process crash.
+//
+// File layout
+//   [0, 4096)  two header copies (front, rear, count, epoch + checksum); flush() writes
+//              the older copy, so a torn header write always leaves a valid one behind
+//   [4096, ..) cap slots of { seq, checksum, record }
+//
+// flush() msyncs the slots before the header, so a durable header never points at
+// records that are not durable. Records enqueued after the last flush are recovered by
+// scanning forward from the header's rear; the scan stops at the first slot whose
+// sequence or checksum does not match, which discards torn records. Dequeues after the
+// last flush are not durable, so recovery is at-least-once.
+template <typename T>
+class journalQueue
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "journalQueue persists records as raw bytes and needs a trivially copyable T");
+
+private:
+    static constexpr std::uint64_t kMagic = 0x4c4e524a51554555ULL;
+    static constexpr std::uint32_t kVersion = 1;
+    static constexpr std::size_t kHeaderBytes = 4096;
+    static constexpr std::size_t kHeaderStride = 512;
+
+    struct header{
+        std::uint64_t magic;
+        std::uint32_t version;
+        std::uint32_t recordSize;
+        std::uint64_t cap;
+        std::uint64_t front;
+        std::uint64_t rear;
+        std::uint64_t count;
+        std::uint64_t frontSeq;     // sequence number of the record at front
+        std::uint64_t epoch;
+        std::uint64_t checksum;
+    };
+
+    struct slot{
+        std::uint64_t seq;
+        std::uint64_t checksum;
+        T value;
+    };
+
+    int fd;
+    char* base;
+    std::size_t mapBytes;
+    slot* slots;
+    std::size_t cap;
+    std::size_t frontIdx;
+    std::size_t rearIdx;
+    std::size_t count;
+    std::uint64_t frontSeq;
+    std::uint64_t epoch;
+    std::size_t flushEvery;
+    std::size_t pendingOps;
+    std::size_t recovered;
+    std::size_t discarded;
+
+    // FNV-1a
+    static std::uint64_t hashBytes(const void* p, std::size_t n, std::uint64_t h = 1469598103934665603ULL){
+        const unsigned char* b = static_cast<const unsigned char*>(p);
+        for(std::size_t i = 0; i < n; i++){
+            h ^= b[i];
+            h *= 1099511628211ULL;
+        }
+        return h;
+    }
+
+    static std::uint64_t headerChecksum(const header& h){
+        return hashBytes(&h, offsetof(header, checksum));
+    }
+
+    static std::uint64_t slotChecksum(const slot& s){
+        return hashBytes(&s.value, sizeof(T), hashBytes(&s.seq, sizeof(s.seq)));
+    }
+
+    header* headerCopy(int i) const{
+        return reinterpret_cast<header*>(base + i * kHeaderStride);
+    }
+
+    bool validSlot(std::size_t idx, std::uint64_t seq) const{
+        return slots[idx].seq == seq && slots[idx].checksum == slotChecksum(slots[idx]);
+    }
+
+    void writeHeader(){
+        header h;
+        std::memset(&h, 0, sizeof(h));
+        h.magic = kMagic;
+        h.version = kVersion;
+        h.recordSize = sizeof(T);
+        h.cap = cap;
+        h.front = frontIdx;
+        h.rear = rearIdx;
+        h.count = count;
+        h.frontSeq = frontSeq;
+        h.epoch = ++epoch;
+        h.checksum = headerChecksum(h);
+        std::memcpy(headerCopy(static_cast<int>(epoch & 1)), &h, sizeof(h));
+    }
+
+    void syncRange(const void* p, std::size_t n){
+        std::uintptr_t page = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+        std::uintptr_t lo = reinterpret_cast<std::uintptr_t>(p) & ~(page - 1);
+        std::uintptr_t hi = reinterpret_cast<std::uintptr_t>(p) + n;
+        if(msync(reinterpret_cast<void*>(lo), hi - lo, MS_SYNC) != 0){
+            throw std::system_error(errno, std::generic_category(), "msync");
+        }
+    }
+
+    // a crash between ftruncate and the first header write leaves both copies zeroed
+    bool blankHeaders() const{
+        for(std::size_t i = 0; i < kHeaderBytes; i++){
+            if(base[i] != 0){
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void recover(){
+        const header* best = nullptr;
+        for(int i = 0; i < 2; i++){
+            const header* h = headerCopy(i);
+            if(h->magic != kMagic || h->checksum != headerChecksum(*h)){
+                continue;
+            }
+            if(best == nullptr || h->epoch > best->epoch){
+                best = h;
+            }
+        }
+        if(best == nullptr){
+            throw std::runtime_error("journalQueue: no valid header");
+        }
+        if(best->version != kVersion || best->recordSize != sizeof(T) || best->cap != cap){
+            throw std::runtime_error("journalQueue: journal has a different record layout");
+        }
+        // a checksum only proves the header is intact, not that it fits this file
+        if(best->front >= cap || best->count > cap){
+            throw std::runtime_error("journalQueue: header points outside the journal");
+        }
+
+        epoch = best->epoch;
+        frontSeq = best->frontSeq;
+        frontIdx = static_cast<std::size_t>(best->front);
+        std::size_t claimed = static_cast<std::size_t>(best->count);
+
+        // slots already reused by a later record mean their old record was consumed
+        while(claimed > 0 && !validSlot(frontIdx, frontSeq) &&
+              slots[frontIdx].seq > frontSeq && (slots[frontIdx].seq - frontSeq) % cap == 0 &&
+              slots[frontIdx].checksum == slotChecksum(slots[frontIdx])){
+            frontSeq++;
+            frontIdx = (frontIdx + 1) % cap;
+            claimed--;
+        }
+
+        // longest valid run: the header's records plus anything enqueued after the last flush
+        count = 0;
+        while(count < cap && validSlot((frontIdx + count) % cap, frontSeq + count)){
+            count++;
+        }
+        if(count < claimed){
+            discarded = claimed - count;
+        }
+        else if(count < cap && slots[(frontIdx + count) % cap].seq == frontSeq + count){
+            // sequence written but payload/checksum torn
+            discarded = 1;
+        }
+        recovered = count;
+        rearIdx = (frontIdx + count) % cap;
+    }
+
+    void afterMutation(){
+        pendingOps++;
+        if(flushEvery != 0 && pendingOps >= flushEvery){
+            flush();
+        }
+    }
+
+public:
+    // ctor: open the journal at path, creating it with cap slots if it does not exist.
+    // flushEvery = n msyncs after every n enqueue/dequeue calls, 0 only on flush()/close
+    journalQueue(const std::string& path, std::size_t cap, std::size_t flushEvery = 1)
+        : fd(-1), base(nullptr), mapBytes(0), slots(nullptr), cap(cap), frontIdx(0), rearIdx(0),
+          count(0), frontSeq(0), epoch(0), flushEvery(flushEvery), pendingOps(0),
+          recovered(0), discarded(0){
+        if(cap == 0){
+            throw std::invalid_argument("journalQueue: capacity must be positive");
+        }
+        fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if(fd < 0){
+            throw std::system_error(errno, std::generic_category(), "open " + path);
+        }
+        mapBytes = kHeaderBytes + cap * sizeof(slot);
+        try
+        {
+            struct stat st;
+            if(fstat(fd, &st) != 0){
+                throw std::system_error(errno, std::generic_category(), "fstat");
+            }
+            bool fresh = st.st_size == 0;
+            if(!fresh && static_cast<std::size_t>(st.st_size) != mapBytes){
+                throw std::runtime_error("journalQueue: " + path + " has a different size/layout");
+            }
+            if(fresh && ftruncate(fd, static_cast<off_t>(mapBytes)) != 0){
+                throw std::system_error(errno, std::generic_category(), "ftruncate");
+            }
+            void* p = mmap(nullptr, mapBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if(p == MAP_FAILED){
+                throw std::system_error(errno, std::generic_category(), "mmap");
+            }
+            base = static_cast<char*>(p);
+            slots = reinterpret_cast<slot*>(base + kHeaderBytes);
+
+            if(!fresh && blankHeaders()){
+                fresh = true;
+            }
+            if(fresh){
+                writeHeader();
+                writeHeader();
+                syncRange(base, kHeaderBytes);
+            }
+            else{
+                recover();
+            }
+        }
+        catch(...)
+        {
+            if(base != nullptr){
+                munmap(base, mapBytes);
+            }
+            close(fd);
+            throw;
+        }
+    }
+
+    journalQueue(const journalQueue&) = delete;
+    journalQueue& operator=(const journalQueue&) = delete;
+
+    // destructor: a clean close is always durable
+    ~journalQueue(){
+        if(base == nullptr){
+            return;
+        }
+        try
+        {
+            flush();
+        }
+        catch(...)
+        {
+        }
+        munmap(base, mapBytes);
+        ::close(fd);
+    }
+
+    void enqueue(const T& value){
+        if(count == cap){
+            throw std::overflow_error("Queue is full");
+        }
+        slot& s = slots[rearIdx];
+        s.value = value;
+        s.seq = frontSeq + count;
+        s.checksum = slotChecksum(s);
+        if(++rearIdx == cap){
+            rearIdx = 0;
+        }
+        count++;
+        afterMutation();
+    }
+
+    void dequeue(){
+        if(count == 0){
+            throw std::underflow_error("Queue is empty");
+        }
+        if(++frontIdx == cap){
+            frontIdx = 0;
+        }
+        frontSeq++;
+        count--;
+        afterMutation();
+    }
+
+    const T& front() const{
+        if(count == 0){
+            throw std::runtime_error("Queue is empty");
+        }
+        return slots[frontIdx].value;
+    }
+
+    const T& back() const{
+        if(count == 0){
+            throw std::runtime_error("Queue is empty");
+        }
+        return slots[(rearIdx + cap - 1) % cap].value;
+    }
+
+    // make every completed operation durable: records first, then the header
+    void flush(){
+        if(count > 0){
+            std::size_t firstLen = std::min(count, cap - frontIdx);
+            syncRange(slots + frontIdx, firstLen * sizeof(slot));
+            if(count > firstLen){
+                syncRange(slots, (count - firstLen) * sizeof(slot));
+            }
+        }
+        writeHeader();
+        syncRange(base, kHeaderBytes);
+        pendingOps = 0;
+    }
+
+    void setFlushInterval(std::size_t n){
+        flushEvery = n;
+    }
+
+    std::size_t flushInterval() const{
+        return flushEvery;
+    }
+
+    // records restored when the journal was opened
+    std::size_t recoveredCount() const{
+        return recovered;
+    }
+
+    // torn or corrupt records thrown away when the journal was opened
+    std::size_t discardedCount() const{
+        return discarded;
+    }
+
+    bool empty() const{
+        return count == 0;
+    }
+
+    bool isFull() const{
+        return count == cap;
+    }
+
+    std::size_t capacity() const{
+        return cap;
+    }
+
+    std::size_t size() const{
+        return count;
+    }
+
+    void clear(){
+        frontSeq += count;
+        frontIdx = rearIdx;
+        count = 0;
+        afterMutation();
+    }
+};
@@ -0,0 +1,297 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <sys/wait.h>
+
+// 包含你的journal queue實現
+#include "journalQueue.cpp"
+
+// 測試計數器
+int tests_passed = 0;
+int tests_total = 0;
+
+// 測試輔助宏
+#define TEST(name) \
+    void test_##name(); \
+    void run_test_##name() { \
+        tests_total++; \
+        std::cout << "Testing " #name "... "; \
+        try { \
+            test_##name(); \
+            tests_passed++; \
+            std::cout << "PASSED\n"; \
+        } catch (const std::exception& e) { \
+            std::cout << "FAILED: " << e.what() << "\n"; \
+        } catch (...) { \
+            std::cout << "FAILED: Unknown exception\n"; \
+        } \
+    } \
+    void test_##name()
+
+struct record {
+    std::uint64_t id;
+    char text[24];
+};
+
+static record make_record(std::uint64_t id) {
+    record r{id, {0}};
+    std::snprintf(r.text, sizeof(r.text), "event-%llu", static_cast<unsigned long long>(id));
+    return r;
+}
+
+// 每個測試用自己的檔案
+static std::string journal_path(const char* tag) {
+    std::string path = "/tmp/journalQueue_test_" + std::to_string(getpid()) + "_" + tag;
+    std::remove(path.c_str());
+    return path;
+}
+
+// 在子行程中執行fn後直接_exit，模擬沒有清理的崩潰
+template <typename Fn>
+void crash_after(Fn fn) {
+    pid_t child = fork();
+    if (child == 0) {
+        fn();
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+}
+
+// ============= 基本功能測試 =============
+
+TEST(basic_fifo) {
+    std::string path = journal_path("basic");
+    journalQueue<record> q(path, 4);
+    assert(q.empty());
+    assert(q.capacity() == 4);
+
+    for (std::uint64_t i = 0; i < 4; i++) q.enqueue(make_record(i));
+    assert(q.isFull());
+    try {
+        q.enqueue(make_record(99));
+        assert(false);
+    } catch (const std::overflow_error&) {
+        // 預期的異常
+    }
+
+    assert(q.front().id == 0);
+    assert(q.back().id == 3);
+    q.dequeue();
+    q.enqueue(make_record(4));  // 環繞
+    assert(q.front().id == 1 && q.back().id == 4);
+    std::remove(path.c_str());
+}
+
+TEST(reopen_after_clean_close) {
+    std::string path = journal_path("reopen");
+    {
+        journalQueue<record> q(path, 8, 0);  // 只在關閉時flush
+        for (std::uint64_t i = 0; i < 6; i++) q.enqueue(make_record(i));
+        q.dequeue();
+        q.dequeue();
+    }
+    journalQueue<record> q(path, 8);
+    assert(q.size() == 4);
+    assert(q.recoveredCount() == 4);
+    assert(q.discardedCount() == 0);
+    assert(q.front().id == 2);
+    assert(std::string(q.back().text) == "event-5");
+
+    // 不同的容量不能打開
+    try {
+        journalQueue<record> wrong(path, 16);
+        assert(false);
+    } catch (const std::runtime_error&) {
+        // 預期的異常
+    }
+    std::remove(path.c_str());
+}
+
+// ============= 崩潰恢復測試 =============
+
+TEST(recover_unflushed_records_after_crash) {
+    std::string path = journal_path("crash");
+    crash_after([&] {
+        journalQueue<record> q(path, 16, 4);
+        for (std::uint64_t i = 0; i < 10; i++) q.enqueue(make_record(i));  // 最後2筆沒有flush
+    });
+
+    journalQueue<record> q(path, 16);
+    assert(q.size() == 10);
+    assert(q.front().id == 0 && q.back().id == 9);
+    std::remove(path.c_str());
+}
+
+TEST(discard_torn_record) {
+    std::string path = journal_path("torn");
+    crash_after([&] {
+        journalQueue<record> q(path, 8, 0);
+        for (std::uint64_t i = 0; i < 5; i++) q.enqueue(make_record(i));
+        q.flush();
+    });
+
+    // 破壞第4筆記錄的內容，模擬寫到一半的崩潰
+    {
+        FILE* f = std::fopen(path.c_str(), "r+b");
+        assert(f != nullptr);
+        std::size_t slotBytes = 2 * sizeof(std::uint64_t) + sizeof(record);
+        std::fseek(f, static_cast<long>(4096 + 3 * slotBytes + 2 * sizeof(std::uint64_t) + 10), SEEK_SET);
+        std::fputc('#', f);
+        std::fclose(f);
+    }
+
+    journalQueue<record> q(path, 8);
+    assert(q.size() == 3);
+    assert(q.discardedCount() == 2);  // 第4筆損壞，第5筆在它之後也被丟棄
+    assert(q.back().id == 2);
+
+    // 恢復後可以繼續使用
+    q.enqueue(make_record(100));
+    assert(q.back().id == 100);
+    std::remove(path.c_str());
+}
+
+TEST(consumed_slots_are_not_replayed) {
+    std::string path = journal_path("wrap");
+    crash_after([&] {
+        journalQueue<record> q(path, 4, 0);
+        for (std::uint64_t i = 0; i < 4; i++) q.enqueue(make_record(i));
+        q.flush();  // header: front=0, count=4
+        q.dequeue();
+        q.dequeue();
+        q.enqueue(make_record(4));  // 覆蓋slot 0、1
+        q.enqueue(make_record(5));
+    });
+
+    journalQueue<record> q(path, 4);
+    assert(q.size() == 4);
+    assert(q.front().id == 2);
+    assert(q.back().id == 5);
+    std::remove(path.c_str());
+}
+
+// 輔助函數：改寫兩份header裡offset處的欄位，並重新計算checksum(FNV-1a，算到offset 64的checksum為止)
+static void rewrite_headers(const std::string& path, long offset, std::uint64_t value) {
+    FILE* f = std::fopen(path.c_str(), "r+b");
+    assert(f != nullptr);
+    for (long copy = 0; copy < 2; copy++) {
+        unsigned char h[72];
+        std::fseek(f, copy * 512, SEEK_SET);
+        assert(std::fread(h, 1, sizeof(h), f) == sizeof(h));
+        std::memcpy(h + offset, &value, sizeof(value));
+        std::uint64_t sum = 1469598103934665603ULL;
+        for (int i = 0; i < 64; i++) {
+            sum ^= h[i];
+            sum *= 1099511628211ULL;
+        }
+        std::memcpy(h + 64, &sum, sizeof(sum));
+        std::fseek(f, copy * 512, SEEK_SET);
+        std::fwrite(h, 1, sizeof(h), f);
+    }
+    std::fclose(f);
+}
+
+TEST(header_out_of_range_is_rejected) {
+    std::string path = journal_path("range");
+    {
+        journalQueue<record> q(path, 4);
+        q.enqueue(make_record(1));
+    }
+    // checksum正確但front超出容量(front在offset 24，count在offset 40)
+    rewrite_headers(path, 24, 7);
+    try {
+        journalQueue<record> q(path, 4);
+        assert(false);
+    } catch (const std::runtime_error&) {
+        // 預期的異常
+    }
+    rewrite_headers(path, 24, 0);
+    rewrite_headers(path, 40, 5);
+    try {
+        journalQueue<record> q(path, 4);
+        assert(false);
+    } catch (const std::runtime_error&) {
+        // 預期的異常
+    }
+    rewrite_headers(path, 40, 1);
+    journalQueue<record> q(path, 4);
+    assert(q.size() == 1 && q.front().id == 1);
+    std::remove(path.c_str());
+}
+
+TEST(crash_before_first_header_write) {
+    std::string path = journal_path("blank");
+    std::size_t slotBytes = 2 * sizeof(std::uint64_t) + sizeof(record);
+    // 只做了ftruncate就崩潰：整個檔案都是0，當成新的journal
+    FILE* f = std::fopen(path.c_str(), "wb");
+    assert(f != nullptr);
+    std::fclose(f);
+    assert(truncate(path.c_str(), static_cast<off_t>(4096 + 4 * slotBytes)) == 0);
+
+    {
+        journalQueue<record> q(path, 4);
+        assert(q.empty() && q.recoveredCount() == 0);
+        q.enqueue(make_record(7));
+    }
+    journalQueue<record> q(path, 4);
+    assert(q.size() == 1 && q.front().id == 7);
+    std::remove(path.c_str());
+}
+
+// ============= 性能測試 =============
+
+TEST(durable_enqueue_throughput) {
+    const std::size_t N = 20000;
+    const std::size_t intervals[] = {1, 16, 256, 0};
+    for (std::size_t every : intervals) {
+        std::string path = journal_path("bench");
+        journalQueue<record> q(path, N, every);
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < N; i++) q.enqueue(make_record(i));
+        q.flush();
+        auto end = std::chrono::steady_clock::now();
+        double sec = std::chrono::duration<double>(end - start).count();
+        std::cout << "\n  flush every " << (every == 0 ? std::string("close") : std::to_string(every))
+                  << ": " << static_cast<long long>(N / sec) << " records/s";
+        assert(q.size() == N);
+        std::remove(path.c_str());
+    }
+    std::cout << " ";
+}
+
+// ============= 主測試函數 =============
+
+int main() {
+    std::cout << "=== JournalQueue 測試套件 ===\n\n";
+
+    // 運行所有測試
+    run_test_basic_fifo();
+    run_test_reopen_after_clean_close();
+    run_test_recover_unflushed_records_after_crash();
+    run_test_discard_torn_record();
+    run_test_consumed_slots_are_not_replayed();
+    run_test_header_out_of_range_is_rejected();
+    run_test_crash_before_first_header_write();
+    run_test_durable_enqueue_throughput();
+
+    // 測試結果
+    std::cout << "\n=== 測試結果 ===\n";
+    std::cout << "通過: " << tests_passed << "/" << tests_total << " 測試\n";
+
+    if (tests_passed == tests_total) {
+        std::cout << "🎉 所有測試通過！\n";
+        return 0;
+    } else {
+        std::cout << "❌ 有 " << (tests_total - tests_passed) << " 個測試失敗\n";
+        return 1;
+    }
+}
@@ -0,0 +1,235 @@
+#include <iostream>
+#include <utility>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// Linux-only ring buffer whose storage is the same memfd mapped twice back-to-back,
+// so data[i] and data[i + cap] alias the same slot. Any window of up to cap elements
+// starting at frontIdx is one contiguous range: no modulo, no split copies.
+// The capacity is rounded up so that cap * sizeof(T) is a multiple of the page size.
+template <typename T>
+class magicRingQueue
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "magicRingQueue stores elements as raw bytes and needs a trivially copyable T");
+
+private:
+    T* data;
+    std::size_t cap;
+    std::size_t frontIdx;
+    std::size_t count;
+
+    static std::size_t gcd(std::size_t a, std::size_t b){
+        while(b != 0){
+            std::size_t t = a % b;
+            a = b;
+            b = t;
+        }
+        return a;
+    }
+
+    static std::size_t roundCapacity(std::size_t minCap){
+        std::size_t page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        std::size_t unit = page / gcd(page, sizeof(T)) * sizeof(T);
+        std::size_t bytes = std::max<std::size_t>(minCap, 1) * sizeof(T);
+        bytes = (bytes + unit - 1) / unit * unit;
+        return bytes / sizeof(T);
+    }
+
+    static T* mapRing(std::size_t cap){
+        std::size_t bytes = cap * sizeof(T);
+        int fd = memfd_create("magicRingQueue", MFD_CLOEXEC);
+        if(fd < 0){
+            throw std::system_error(errno, std::generic_category(), "memfd_create");
+        }
+        if(ftruncate(fd, static_cast<off_t>(bytes)) != 0){
+            int err = errno;
+            close(fd);
+            throw std::system_error(err, std::generic_category(), "ftruncate");
+        }
+
+        // reserve 2 * bytes of address space, then map the file over both halves
+        void* base = mmap(nullptr, 2 * bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if(base == MAP_FAILED){
+            int err = errno;
+            close(fd);
+            throw std::system_error(err, std::generic_category(), "mmap reserve");
+        }
+        char* lo = static_cast<char*>(base);
+        if(mmap(lo, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED ||
+           mmap(lo + bytes, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED){
+            int err = errno;
+            munmap(base, 2 * bytes);
+            close(fd);
+            throw std::system_error(err, std::generic_category(), "mmap mirror");
+        }
+        // the two mappings keep the memfd alive
+        close(fd);
+        return reinterpret_cast<T*>(lo);
+    }
+
+    static void unmapRing(T* data, std::size_t cap){
+        if(data != nullptr){
+            munmap(data, 2 * cap * sizeof(T));
+        }
+    }
+
+public:
+    // a contiguous run of slots; may extend past cap into the mirror
+    struct span{
+        T* ptr;
+        std::size_t len;
+    };
+
+    // ctor, capacity is rounded up to a whole number of pages
+    explicit magicRingQueue(std::size_t minCap) : cap(roundCapacity(minCap)), frontIdx(0), count(0){
+        data = mapRing(cap);
+    }
+
+    // copy ctor
+    magicRingQueue(const magicRingQueue& other) : cap(other.cap), frontIdx(0), count(other.count){
+        data = mapRing(cap);
+        std::memcpy(data, other.data + other.frontIdx, count * sizeof(T));
+    }
+
+    // move ctor
+    magicRingQueue(magicRingQueue&& other) noexcept :
+        data(std::exchange(other.data, nullptr)),
+        cap(std::exchange(other.cap, 0)),
+        frontIdx(std::exchange(other.frontIdx, 0)),
+        count(std::exchange(other.count, 0)){}
+
+    // copy & move assignment
+    magicRingQueue& operator=(magicRingQueue other) noexcept{
+        swap(other);
+        return *this;
+    }
+
+    // destructor
+    ~magicRingQueue(){
+        unmapRing(data, cap);
+    }
+
+    void swap(magicRingQueue& other) noexcept{
+        std::swap(data, other.data);
+        std::swap(cap, other.cap);
+        std::swap(frontIdx, other.frontIdx);
+        std::swap(count, other.count);
+    }
+
+    void enqueue(const T& value){
+        if(count == cap){
+            throw std::overflow_error("Queue is full");
+        }
+        data[frontIdx + count] = value;
+        count++;
+    }
+
+    void dequeue(){
+        if(count == 0){
+            throw std::underflow_error("Queue is empty");
+        }
+        if(++frontIdx == cap){
+            frontIdx = 0;
+        }
+        count--;
+    }
+
+    const T& front() const{
+        if(count == 0){
+            throw std::runtime_error("Queue is empty");
+        }
+        return data[frontIdx];
+    }
+
+    const T& back() const{
+        if(count == 0){
+            throw std::runtime_error("Queue is empty");
+        }
+        return data[frontIdx + count - 1];
+    }
+
+    // i-th element from the front, unchecked
+    const T& operator[](std::size_t i) const{
+        return data[frontIdx + i];
+    }
+
+    // all occupied slots oldest-first as a single contiguous range
+    span readable(){
+        return span{data + frontIdx, count};
+    }
+
+    // all free slots in enqueue order as a single contiguous range
+    span writable(){
+        return span{data + frontIdx + count, cap - count};
+    }
+
+    void commit_read(std::size_t n){
+        if(n > count){
+            throw std::underflow_error("commit_read past the end of the queue");
+        }
+        frontIdx += n;
+        if(frontIdx >= cap){
+            frontIdx -= cap;
+        }
+        count -= n;
+    }
+
+    void commit_write(std::size_t n){
+        if(n > cap - count){
+            throw std::overflow_error("commit_write past the free space of the queue");
+        }
+        count += n;
+    }
+
+    // copy up to n elements from src with a single memcpy, returns how many were taken
+    std::size_t enqueue_bulk(const T* src, std::size_t n){
+        n = std::min(n, cap - count);
+        std::memcpy(data + frontIdx + count, src, n * sizeof(T));
+        count += n;
+        return n;
+    }
+
+    // copy up to n elements into dst with a single memcpy, returns how many were taken
+    std::size_t dequeue_bulk(T* dst, std::size_t n){
+        n = std::min(n, count);
+        std::memcpy(dst, data + frontIdx, n * sizeof(T));
+        commit_read(n);
+        return n;
+    }
+
+    bool empty() const{
+        return count == 0;
+    }
+
+    bool isFull() const{
+        return count == cap;
+    }
+
+    std::size_t capacity() const{
+        return cap;
+    }
+
+    std::size_t size() const{
+        return count;
+    }
+
+    void clear(){
+        frontIdx = 0;
+        count = 0;
+    }
+
+    void print() const{
+        std::cout << "Queue(front -> back) : ";
+        for(std::size_t i = 0; i < count; i++){
+            std::cout << data[frontIdx + i] << " ";
+        }
+        std::cout << std::endl;
+    }
+};
@@ -0,0 +1,246 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <chrono>
+#include <cstring>
+#include <cstdint>
+
+// 包含magic ring buffer與一般circular queue實現
+#include "magicRingQueue.cpp"
+#include "circularQueue.cpp"
+
+// 測試計數器
+int tests_passed = 0;
+int tests_total = 0;
+
+// 測試輔助宏
+#define TEST(name) \
+    void test_##name(); \
+    void run_test_##name() { \
+        tests_total++; \
+        std::cout << "Testing " #name "... "; \
+        try { \
+            test_##name(); \
+            tests_passed++; \
+            std::cout << "PASSED\n"; \
+        } catch (const std::exception& e) { \
+            std::cout << "FAILED: " << e.what() << "\n"; \
+        } catch (...) { \
+            std::cout << "FAILED: Unknown exception\n"; \
+        } \
+    } \
+    void test_##name()
+
+// ============= 基本功能測試 =============
+
+TEST(constructor_rounds_to_pages) {
+    magicRingQueue<int> q(10);
+    std::size_t page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    assert(q.capacity() >= 10);
+    assert((q.capacity() * sizeof(int)) % page == 0);
+    assert(q.empty());
+    assert(!q.isFull());
+}
+
+TEST(enqueue_and_dequeue_basic) {
+    magicRingQueue<int> q(4);
+    q.enqueue(1);
+    q.enqueue(2);
+    q.enqueue(3);
+    assert(q.size() == 3);
+    assert(q.front() == 1);
+    assert(q.back() == 3);
+
+    q.dequeue();
+    assert(q.front() == 2);
+    assert(q[1] == 3);
+
+    q.dequeue();
+    q.dequeue();
+    assert(q.empty());
+
+    try {
+        q.dequeue();
+        assert(false);
+    } catch (const std::underflow_error&) {
+        // 預期的異常
+    }
+}
+
+TEST(overflow_exception) {
+    magicRingQueue<char> q(1);
+    for (std::size_t i = 0; i < q.capacity(); i++) q.enqueue('x');
+    assert(q.isFull());
+    try {
+        q.enqueue('y');
+        assert(false);
+    } catch (const std::overflow_error&) {
+        // 預期的異常
+    }
+}
+
+// ============= 連續視圖測試 =============
+
+TEST(wrapped_window_is_contiguous) {
+    magicRingQueue<int> q(1);
+    const std::size_t CAP = q.capacity();
+
+    // 讓front停在緩衝區尾端附近，資料環繞到開頭
+    for (std::size_t i = 0; i < CAP - 3; i++) q.enqueue(0);
+    q.commit_read(CAP - 3);
+    for (int i = 0; i < 10; i++) q.enqueue(i);
+
+    auto r = q.readable();
+    assert(r.len == 10);
+    for (int i = 0; i < 10; i++) {
+        assert(r.ptr[i] == i);  // 跨越環繞點仍然是同一段連續記憶體
+    }
+
+    auto w = q.writable();
+    assert(w.len == CAP - 10);
+    w.ptr[0] = 42;
+    q.commit_write(1);
+    assert(q.back() == 42);
+
+    int out[11];
+    assert(q.dequeue_bulk(out, 100) == 11);
+    assert(out[0] == 0 && out[9] == 9 && out[10] == 42);
+    assert(q.empty());
+}
+
+TEST(copy_and_move) {
+    magicRingQueue<int> a(1);
+    for (std::size_t i = 0; i < a.capacity() - 1; i++) a.enqueue(0);
+    a.commit_read(a.capacity() - 1);
+    int src[3] = {7, 8, 9};
+    assert(a.enqueue_bulk(src, 3) == 3);
+
+    magicRingQueue<int> b = a;  // 拷貝構造
+    assert(b.size() == 3 && b.front() == 7 && b.back() == 9);
+    a.dequeue();
+    assert(b.front() == 7);
+
+    magicRingQueue<int> c = std::move(b);  // 移動構造
+    assert(c.size() == 3);
+    assert(b.empty());
+
+    b = c;  // 賦值
+    assert(b.size() == 3 && b[2] == 9);
+}
+
+// ============= 變長記錄解析性能測試 =============
+
+// 記錄格式：[uint16_t len][len bytes payload]
+static std::size_t write_record(unsigned char* dst, uint16_t len, unsigned char fill) {
+    std::memcpy(dst, &len, sizeof(len));
+    std::memset(dst + sizeof(len), fill, len);
+    return sizeof(len) + len;
+}
+
+TEST(record_parsing_performance) {
+    const int RECORDS = 2000000;
+    const std::size_t RING = 64 * 1024;
+    unsigned char record[2 + 512];
+
+    // magic ring：直接在環上解析，沒有環繞處理
+    magicRingQueue<unsigned char> magic(RING);
+    uint64_t magicSum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < RECORDS; i++) {
+        uint16_t len = static_cast<uint16_t>(16 + (i * 37) % 480);
+        auto w = magic.writable();
+        if (w.len < sizeof(uint16_t) + len) {
+            // 消費者：一次性解析所有完整記錄
+            auto r = magic.readable();
+            std::size_t off = 0;
+            while (off < r.len) {
+                uint16_t l;
+                std::memcpy(&l, r.ptr + off, sizeof(l));
+                magicSum += l + r.ptr[off + sizeof(l) + l - 1];
+                off += sizeof(l) + l;
+            }
+            magic.commit_read(off);
+            w = magic.writable();
+        }
+        magic.commit_write(write_record(w.ptr, len, static_cast<unsigned char>(i)));
+    }
+    auto mid = std::chrono::steady_clock::now();
+
+    // 一般circularQueue：記錄跨越環繞點時要先拷貝到暫存區
+    circularQueue<unsigned char> plain(static_cast<int>(magic.capacity()));
+    uint64_t plainSum = 0;
+    unsigned char scratch[2 + 512];
+    auto drain = [&]() {
+        while (!plain.empty()) {
+            auto r = plain.readable_spans();
+            uint16_t l;
+            unsigned char header[sizeof(l)];
+            std::size_t head = std::min(sizeof(l), r.first.len);
+            std::memcpy(header, r.first.ptr, head);
+            std::memcpy(header + head, r.second.ptr, sizeof(l) - head);
+            std::memcpy(&l, header, sizeof(l));
+
+            const unsigned char* p = r.first.ptr;
+            if (r.first.len >= sizeof(l) + l) {
+                plain.commit_read(sizeof(l) + l);
+            } else {
+                plain.dequeue_bulk(scratch, sizeof(l) + l);
+                p = scratch;
+            }
+            plainSum += l + p[sizeof(l) + l - 1];
+        }
+    };
+    for (int i = 0; i < RECORDS; i++) {
+        uint16_t len = static_cast<uint16_t>(16 + (i * 37) % 480);
+        std::size_t n = write_record(record, len, static_cast<unsigned char>(i));
+        if (plain.capacity() - plain.size() < n) drain();
+        plain.enqueue_bulk(record, n);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    // 收尾：把兩邊剩下的記錄也算進去
+    auto r = magic.readable();
+    std::size_t off = 0;
+    while (off < r.len) {
+        uint16_t l;
+        std::memcpy(&l, r.ptr + off, sizeof(l));
+        magicSum += l + r.ptr[off + sizeof(l) + l - 1];
+        off += sizeof(l) + l;
+    }
+    drain();
+
+    auto magicMs = std::chrono::duration_cast<std::chrono::milliseconds>(mid - start).count();
+    auto plainMs = std::chrono::duration_cast<std::chrono::milliseconds>(end - mid).count();
+    std::cout << "\n  magic ring: " << magicMs << "ms, circularQueue: " << plainMs << "ms ("
+              << RECORDS << " records) ";
+    assert(magicSum == plainSum);
+}
+
+// ============= 主測試函數 =============
+
+int main() {
+    std::cout << "=== MagicRingQueue 測試套件 ===\n\n";
+
+    // 運行所有測試
+    run_test_constructor_rounds_to_pages();
+    run_test_enqueue_and_dequeue_basic();
+    run_test_overflow_exception();
+    run_test_wrapped_window_is_contiguous();
+    run_test_copy_and_move();
+    run_test_record_parsing_performance();
+
+    // 測試結果
+    std::cout << "\n=== 測試結果 ===\n";
+    std::cout << "通過: " << tests_passed << "/" << tests_total << " 測試\n";
+
+    if (tests_passed == tests_total) {
+        std::cout << "🎉 所有測試通過！\n";
+        return 0;
+    } else {
+        std::cout << "❌ 有 " << (tests_total - tests_passed) << " 個測試失敗\n";
+        return 1;
+    }
+}
@@ -0,0 +1,145 @@
+#include <iostream>
+#include <utility>
+#include <stdexcept>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+
+// Bounded lock-free MPMC ring (Vyukov): every slot carries a sequence number that says
+// whether it is ready for the producer of lap n or the consumer of lap n. A producer
+// claims a position with one CAS on the tail, a consumer with one CAS on the head, and
+// neither touches the other's counter, so producers and consumers do not contend.
+// Capacity is rounded up to a power of two.
+template <typename T>
+class mpmcRing
+{
+private:
+    struct alignas(64) slot{
+        std::atomic<std::uint64_t> seq;
+        T value;
+    };
+
+    std::unique_ptr<slot[]> slots;
+    std::size_t mask;
+    alignas(64) std::atomic<std::uint64_t> tail{0};
+    alignas(64) std::atomic<std::uint64_t> head{0};
+
+    static std::size_t roundPow2(std::size_t n){
+        std::size_t p = 1;
+        while(p < n){
+            p <<= 1;
+        }
+        return p;
+    }
+
+    // claims the next tail slot, nullptr if the ring is full
+    slot* claimTail(std::uint64_t& pos){
+        pos = tail.load(std::memory_order_relaxed);
+        for(;;){
+            slot* s = &slots[pos & mask];
+            std::uint64_t seq = s->seq.load(std::memory_order_acquire);
+            std::int64_t diff = static_cast<std::int64_t>(seq - pos);
+            if(diff == 0){
+                if(tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)){
+                    return s;
+                }
+            }
+            else if(diff < 0){
+                return nullptr;
+            }
+            else{
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+public:
+    // ctor
+    explicit mpmcRing(std::size_t cap) : slots(nullptr), mask(0){
+        if(cap == 0){
+            throw std::invalid_argument("mpmcRing capacity must be positive");
+        }
+        cap = roundPow2(cap);
+        slots.reset(new slot[cap]);
+        mask = cap - 1;
+        for(std::size_t i = 0; i < cap; i++){
+            slots[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    mpmcRing(const mpmcRing&) = delete;
+    mpmcRing& operator=(const mpmcRing&) = delete;
+
+    bool tryEnqueue(const T& value){
+        std::uint64_t pos;
+        slot* s = claimTail(pos);
+        if(s == nullptr){
+            return false;
+        }
+        s->value = value;
+        s->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryEnqueue(T&& value){
+        std::uint64_t pos;
+        slot* s = claimTail(pos);
+        if(s == nullptr){
+            return false;
+        }
+        s->value = std::move(value);
+        s->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryDequeue(T& out){
+        std::uint64_t pos = head.load(std::memory_order_relaxed);
+        for(;;){
+            slot* s = &slots[pos & mask];
+            std::uint64_t seq = s->seq.load(std::memory_order_acquire);
+            std::int64_t diff = static_cast<std::int64_t>(seq - (pos + 1));
+            if(diff == 0){
+                if(head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)){
+                    out = std::move(s->value);
+                    s->seq.store(pos + mask + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if(diff < 0){
+                return false;
+            }
+            else{
+                pos = head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void enqueue(const T& value){
+        if(!tryEnqueue(value)){
+            throw std::overflow_error("Queue is full");
+        }
+    }
+
+    T dequeue(){
+        T out;
+        if(!tryDequeue(out)){
+            throw std::underflow_error("Queue is empty");
+        }
+        return out;
+    }
+
+    // snapshot, may be stale by the time it returns
+    std::size_t size() const{
+        std::uint64_t h = head.load(std::memory_order_acquire);
+        std::uint64_t t = tail.load(std::memory_order_acquire);
+        return t > h ? static_cast<std::size_t>(t - h) : 0;
+    }
+
+    bool empty() const{
+        return size() == 0;
+    }
+
+    std::size_t capacity() const{
+        return mask + 1;
+    }
+};
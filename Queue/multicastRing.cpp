@@ -0,0 +1,230 @@
+#include <iostream>
+#include <utility>
+#include <stdexcept>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <limits>
+#include <cstdint>
+
+// wait strategies: waitUntil(ready) returns once ready() is true, notifyAll() is called
+// after every cursor move so blocked waiters can re-check
+
+// lowest latency, burns a core per waiter
+struct busySpinWait
+{
+    template <typename Pred>
+    void waitUntil(Pred ready){
+        while(!ready()){
+        }
+    }
+
+    void notifyAll(){}
+};
+
+// spins through the scheduler, good default when threads outnumber cores
+struct yieldingWait
+{
+    template <typename Pred>
+    void waitUntil(Pred ready){
+        while(!ready()){
+            std::this_thread::yield();
+        }
+    }
+
+    void notifyAll(){}
+};
+
+// parks on a condition variable; notifyAll only takes the lock when someone is parked
+struct blockingWait
+{
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::atomic<int> waiters{0};
+
+    template <typename Pred>
+    void waitUntil(Pred ready){
+        if(ready()){
+            return;
+        }
+        std::unique_lock<std::mutex> lock(mtx);
+        waiters.fetch_add(1);
+        // pairs with the seq_cst cursor stores so either we see the new value or the
+        // notifier sees us waiting
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        cv.wait(lock, ready);
+        waiters.fetch_sub(1);
+    }
+
+    void notifyAll(){
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(waiters.load() > 0){
+            std::lock_guard<std::mutex> lock(mtx);
+            cv.notify_all();
+        }
+    }
+};
+
+// Disruptor-style single-producer multicast ring: every published event is seen by
+// every consumer. Each consumer owns a sequence cursor; the producer never overwrites
+// a slot until the slowest consumer has released it, and a consumer can depend on
+// other consumers so it only sees events they have already processed.
+template <typename T, typename WaitStrategy = yieldingWait>
+class multicastRing
+{
+public:
+    class consumer
+    {
+        friend class multicastRing;
+
+    private:
+        alignas(64) std::atomic<std::int64_t> seq{-1};   // last released sequence
+        std::vector<const consumer*> deps;
+
+    public:
+        std::int64_t sequence() const{
+            return seq.load(std::memory_order_acquire);
+        }
+    };
+
+private:
+    T* data;
+    std::size_t cap;
+    std::size_t mask;
+    alignas(64) std::atomic<std::int64_t> cursor{-1};     // last published sequence
+    alignas(64) std::int64_t cachedGate = -1;             // producer-local
+    std::atomic<bool> closed{false};
+    std::vector<std::unique_ptr<consumer>> consumers;
+    WaitStrategy waiter;
+
+    static std::size_t roundPow2(std::size_t n){
+        std::size_t p = 1;
+        while(p < n){
+            p <<= 1;
+        }
+        return p;
+    }
+
+    std::int64_t minConsumerSeq() const{
+        std::int64_t lo = cursor.load(std::memory_order_relaxed);
+        for(const auto& c : consumers){
+            lo = std::min(lo, c->seq.load(std::memory_order_acquire));
+        }
+        return lo;
+    }
+
+    std::int64_t available(const consumer& c) const{
+        std::int64_t hi = cursor.load(std::memory_order_acquire);
+        for(const consumer* d : c.deps){
+            hi = std::min(hi, d->seq.load(std::memory_order_acquire));
+        }
+        return hi;
+    }
+
+public:
+    // ctor, cap is rounded up to a power of two
+    explicit multicastRing(std::size_t cap) : cap(roundPow2(cap == 0 ? 1 : cap)){
+        mask = this->cap - 1;
+        data = new T[this->cap];
+    }
+
+    multicastRing(const multicastRing&) = delete;
+    multicastRing& operator=(const multicastRing&) = delete;
+
+    // destructor
+    ~multicastRing(){
+        delete [] data;
+    }
+
+    // register a consumer before the first publish; it will only see events that
+    // every consumer in dependsOn has already released
+    consumer& addConsumer(std::vector<const consumer*> dependsOn = {}){
+        if(cursor.load(std::memory_order_relaxed) != -1){
+            throw std::logic_error("multicastRing: consumers must be added before publishing");
+        }
+        consumers.emplace_back(new consumer);
+        consumers.back()->deps = std::move(dependsOn);
+        return *consumers.back();
+    }
+
+    // producer: waits for the slowest consumer to free the slot, then publishes
+    void publish(const T& value){
+        std::int64_t next = cursor.load(std::memory_order_relaxed) + 1;
+        std::int64_t wrapPoint = next - static_cast<std::int64_t>(cap);
+        if(cachedGate < wrapPoint){
+            waiter.waitUntil([&]{
+                cachedGate = minConsumerSeq();
+                return cachedGate >= wrapPoint;
+            });
+        }
+        data[next & mask] = value;
+        cursor.store(next, std::memory_order_seq_cst);
+        waiter.notifyAll();
+    }
+
+    // no more events; wakes every waiting consumer
+    void close(){
+        closed.store(true, std::memory_order_seq_cst);
+        waiter.notifyAll();
+    }
+
+    bool isClosed() const{
+        return closed.load(std::memory_order_acquire);
+    }
+
+    // consumer: highest sequence it may read, blocking until there is at least one new
+    // event. Returns c.sequence() only once the ring is closed and fully drained.
+    std::int64_t waitFor(const consumer& c){
+        std::int64_t next = c.seq.load(std::memory_order_relaxed) + 1;
+        std::int64_t hi = -1;
+        waiter.waitUntil([&]{
+            // once closed the cursor is final; a dependent consumer is only drained
+            // after its dependencies have caught up with it
+            bool done = closed.load(std::memory_order_acquire);
+            hi = available(c);
+            return hi >= next || (done && hi >= cursor.load(std::memory_order_acquire));
+        });
+        return hi;
+    }
+
+    const T& get(std::int64_t seq) const{
+        return data[seq & mask];
+    }
+
+    // consumer: mark everything up to and including seq as processed
+    void release(consumer& c, std::int64_t seq){
+        c.seq.store(seq, std::memory_order_seq_cst);
+        waiter.notifyAll();
+    }
+
+    // consumer: wait for a batch, hand every event to fn, release it.
+    // Returns the batch size, 0 once the ring is closed and drained.
+    template <typename Fn>
+    std::size_t consume(consumer& c, Fn fn){
+        std::int64_t from = c.seq.load(std::memory_order_relaxed) + 1;
+        std::int64_t hi = waitFor(c);
+        for(std::int64_t s = from; s <= hi; s++){
+            fn(data[s & mask], s);
+        }
+        if(hi >= from){
+            release(c, hi);
+            return static_cast<std::size_t>(hi - from + 1);
+        }
+        return 0;
+    }
+
+    std::int64_t published() const{
+        return cursor.load(std::memory_order_acquire);
+    }
+
+    std::size_t capacity() const{
+        return cap;
+    }
+
+    std::size_t consumerCount() const{
+        return consumers.size();
+    }
+};
@@ -0,0 +1,227 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <cstdint>
+
+// 包含multicast ring與circular queue實現
+#include "multicastRing.cpp"
+#include "circularQueue.cpp"
+
+// 測試計數器
+int tests_passed = 0;
+int tests_total = 0;
+
+// 測試輔助宏
+#define TEST(name) \
+    void test_##name(); \
+    void run_test_##name() { \
+        tests_total++; \
+        std::cout << "Testing " #name "... "; \
+        try { \
+            test_##name(); \
+            tests_passed++; \
+            std::cout << "PASSED\n"; \
+        } catch (const std::exception& e) { \
+            std::cout << "FAILED: " << e.what() << "\n"; \
+        } catch (...) { \
+            std::cout << "FAILED: Unknown exception\n"; \
+        } \
+    } \
+    void test_##name()
+
+// ============= 基本功能測試 =============
+
+TEST(single_thread_multicast) {
+    multicastRing<int> ring(4);
+    assert(ring.capacity() == 4);
+
+    auto& a = ring.addConsumer();
+    auto& b = ring.addConsumer();
+    assert(ring.consumerCount() == 2);
+
+    ring.publish(1);
+    ring.publish(2);
+    ring.publish(3);
+
+    // 每個consumer都看到全部事件
+    std::vector<int> seenA, seenB;
+    assert(ring.consume(a, [&](const int& v, std::int64_t) { seenA.push_back(v); }) == 3);
+    assert(ring.consume(b, [&](const int& v, std::int64_t) { seenB.push_back(v); }) == 3);
+    assert((seenA == std::vector<int>{1, 2, 3}));
+    assert(seenA == seenB);
+
+    // 註冊時機錯誤
+    try {
+        ring.addConsumer();
+        assert(false);
+    } catch (const std::logic_error&) {
+        // 預期的異常
+    }
+}
+
+TEST(close_drains_then_stops) {
+    multicastRing<int> ring(8);
+    auto& c = ring.addConsumer();
+    ring.publish(7);
+    ring.close();
+    assert(ring.isClosed());
+
+    int got = 0;
+    assert(ring.consume(c, [&](const int& v, std::int64_t) { got = v; }) == 1);
+    assert(got == 7);
+    assert(ring.consume(c, [&](const int&, std::int64_t) {}) == 0);
+}
+
+// ============= 多執行緒測試 =============
+
+template <typename Wait>
+void run_pipeline(std::int64_t N) {
+    multicastRing<std::int64_t, Wait> ring(64);
+    auto& journal = ring.addConsumer();
+    auto& metrics = ring.addConsumer();
+    auto& replicate = ring.addConsumer({&journal});  // 依賴鏈：必須在journal之後
+
+    std::int64_t sumJ = 0, sumM = 0, sumR = 0;
+    bool orderOk = true;
+    std::thread tj([&] {
+        while (ring.consume(journal, [&](const std::int64_t& v, std::int64_t) { sumJ += v; })) {}
+    });
+    std::thread tm([&] {
+        while (ring.consume(metrics, [&](const std::int64_t& v, std::int64_t) { sumM += v; })) {}
+    });
+    std::thread tr([&] {
+        while (ring.consume(replicate, [&](const std::int64_t&, std::int64_t s) {
+            if (journal.sequence() < s) orderOk = false;
+            sumR += 1;
+        })) {}
+    });
+
+    for (std::int64_t i = 0; i < N; i++) ring.publish(i);
+    ring.close();
+    tj.join();
+    tm.join();
+    tr.join();
+
+    assert(sumJ == N * (N - 1) / 2);
+    assert(sumM == sumJ);
+    assert(sumR == N);
+    assert(orderOk);
+}
+
+TEST(wait_strategies_and_dependencies) {
+    run_pipeline<yieldingWait>(100000);
+    run_pipeline<blockingWait>(100000);
+    // busy-spin只有在每個執行緒有自己的核心時才合理
+    if (std::thread::hardware_concurrency() >= 4) {
+        run_pipeline<busySpinWait>(100000);
+    }
+}
+
+// ============= 性能測試 =============
+
+TEST(multicast_vs_separate_queues) {
+    const std::int64_t N = 1000000;
+    const int CONSUMERS = 3;
+
+    // 一個multicast ring
+    auto start = std::chrono::steady_clock::now();
+    {
+        multicastRing<std::int64_t, yieldingWait> ring(1024);
+        std::vector<multicastRing<std::int64_t, yieldingWait>::consumer*> cs;
+        for (int i = 0; i < CONSUMERS; i++) cs.push_back(&ring.addConsumer());
+        std::vector<std::thread> threads;
+        std::vector<std::int64_t> sums(CONSUMERS, 0);
+        for (int i = 0; i < CONSUMERS; i++) {
+            threads.emplace_back([&, i] {
+                while (ring.consume(*cs[i], [&](const std::int64_t& v, std::int64_t) { sums[i] += v; })) {}
+            });
+        }
+        for (std::int64_t i = 0; i < N; i++) ring.publish(i);
+        ring.close();
+        for (auto& t : threads) t.join();
+        for (auto s : sums) assert(s == N * (N - 1) / 2);
+    }
+    auto mid = std::chrono::steady_clock::now();
+
+    // N個獨立的circularQueue，每個事件複製N次
+    {
+        struct lockedQueue {
+            std::mutex mtx;
+            circularQueue<std::int64_t> q{1024};
+        };
+        std::vector<lockedQueue> queues(CONSUMERS);
+        std::vector<std::int64_t> sums(CONSUMERS, 0);
+        std::vector<std::thread> threads;
+        for (int i = 0; i < CONSUMERS; i++) {
+            threads.emplace_back([&, i] {
+                std::int64_t buf[256];
+                std::int64_t got = 0;
+                while (got < N) {
+                    std::size_t n;
+                    {
+                        std::lock_guard<std::mutex> lock(queues[i].mtx);
+                        n = queues[i].q.dequeue_bulk(buf, 256);
+                    }
+                    if (n == 0) {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    for (std::size_t k = 0; k < n; k++) sums[i] += buf[k];
+                    got += static_cast<std::int64_t>(n);
+                }
+            });
+        }
+        for (std::int64_t i = 0; i < N; i++) {
+            for (auto& lq : queues) {
+                for (;;) {
+                    {
+                        std::lock_guard<std::mutex> lock(lq.mtx);
+                        if (!lq.q.isFull()) {
+                            lq.q.enqueue(i);
+                            break;
+                        }
+                    }
+                    std::this_thread::yield();
+                }
+            }
+        }
+        for (auto& t : threads) t.join();
+        for (auto s : sums) assert(s == N * (N - 1) / 2);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    auto ringMs = std::chrono::duration_cast<std::chrono::milliseconds>(mid - start).count();
+    auto queuesMs = std::chrono::duration_cast<std::chrono::milliseconds>(end - mid).count();
+    std::cout << "\n  multicast ring: " << ringMs << "ms, " << CONSUMERS << " locked circularQueues: "
+              << queuesMs << "ms (" << N << " events) ";
+}
+
+// ============= 主測試函數 =============
+
+int main() {
+    std::cout << "=== MulticastRing 測試套件 ===\n\n";
+
+    // 運行所有測試
+    run_test_single_thread_multicast();
+    run_test_close_drains_then_stops();
+    run_test_wait_strategies_and_dependencies();
+    run_test_multicast_vs_separate_queues();
+
+    // 測試結果
+    std::cout << "\n=== 測試結果 ===\n";
+    std::cout << "通過: " << tests_passed << "/" << tests_total << " 測試\n";
+
+    if (tests_passed == tests_total) {
+        std::cout << "🎉 所有測試通過！\n";
+        return 0;
+    } else {
+        std::cout << "❌ 有 " << (tests_total - tests_passed) << " 個測試失敗\n";
+        return 1;
+    }
+}
@@ -0,0 +1,182 @@
+#include <iostream>
+#include <utility>
+#include <stdexcept>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+#include "queue.cpp"
+
+enum class handoffMode { doubleBuffer, tripleBuffer };
+
+// Whole-frame hand-off between one producer and one consumer. The frames are queue<T>
+// objects that are cleared and reused, never freed, so after the first few frames no
+// allocation happens; handing a frame over is an index swap, not a copy per element.
+//
+//   producer:  queue<T>& f = pp.acquire_write();  f.enqueue(...) ...;  pp.publish();
+//   consumer:  queue<T>* f = pp.acquire_read();   read *f ...;         pp.release();
+//
+// doubleBuffer: two frames. The producer fills one while the consumer works on the
+// other; every published frame is read exactly once and in order. acquire_write()
+// waits for a free frame, acquire_read() for a published one; after close() it returns
+// nullptr once the published frames are drained.
+//
+// tripleBuffer: three frames, nobody ever waits. publish() swaps the frame just written
+// with the "latest" slot (an unread older frame there is dropped), acquire_read() swaps
+// the latest slot in if it is newer than what the reader holds and returns it, or keeps
+// returning the same frame; nullptr until the first publish. release() and close() are
+// no-ops.
+// readSequence() tells the reader which frame it got.
+template <typename T>
+class pingPongBuffer
+{
+private:
+    enum : std::uint8_t { kFree, kWriting, kReady, kReading };
+    static constexpr std::uint8_t kFresh = 4;      // tripleBuffer: latest slot not read yet
+    static constexpr int kNone = -1;
+
+    ::queue<T> frames[3];                           // doubleBuffer leaves the third one unused
+    std::uint64_t seq[3] = {0, 0, 0};               // publish number of each frame's contents
+    handoffMode mode;
+    int writeIdx = kNone;
+    int readIdx = kNone;
+    std::uint64_t published = 0;
+    std::uint64_t readSeq = 0;
+
+    // doubleBuffer
+    std::uint8_t state[2] = {kFree, kFree};
+    std::mutex m;
+    std::condition_variable cv;
+    bool closed = false;
+
+    // tripleBuffer: index of the latest frame, | kFresh until the reader takes it
+    std::atomic<std::uint8_t> latest{1};
+
+public:
+    // ctor: each frame starts with room for frameCap elements
+    explicit pingPongBuffer(std::size_t frameCap, handoffMode mode = handoffMode::doubleBuffer)
+        : frames{::queue<T>(frameCap), ::queue<T>(frameCap),
+                 ::queue<T>(mode == handoffMode::tripleBuffer ? frameCap : 0)},
+          mode(mode){
+        if(mode == handoffMode::tripleBuffer){
+            writeIdx = 0;
+            readIdx = 2;
+        }
+    }
+
+    pingPongBuffer(const pingPongBuffer&) = delete;
+    pingPongBuffer& operator=(const pingPongBuffer&) = delete;
+
+    // call before use: moves every frame into a reserved mapping, see queue::reserve
+    void reserve(std::size_t n, bool prefault = true, bool huge = true){
+        for(int i = 0; i < (mode == handoffMode::tripleBuffer ? 3 : 2); i++){
+            frames[i].reserve(n, prefault, huge);
+        }
+    }
+
+    // an empty frame owned by the producer until publish()
+    ::queue<T>& acquire_write(){
+        if(mode == handoffMode::tripleBuffer){
+            frames[writeIdx].clear();
+            return frames[writeIdx];
+        }
+        std::unique_lock<std::mutex> lock(m);
+        if(closed){
+            throw std::logic_error("pingPongBuffer: acquire_write after close");
+        }
+        if(writeIdx != kNone){
+            throw std::logic_error("pingPongBuffer: frame already acquired for writing");
+        }
+        cv.wait(lock, [&]{ return state[0] == kFree || state[1] == kFree || closed; });
+        if(closed){
+            // close() while waiting: the consumer may be gone, nobody would free a frame
+            throw std::logic_error("pingPongBuffer: acquire_write after close");
+        }
+        writeIdx = state[0] == kFree ? 0 : 1;
+        state[writeIdx] = kWriting;
+        lock.unlock();
+        frames[writeIdx].clear();
+        return frames[writeIdx];
+    }
+
+    // hands the frame from acquire_write() to the consumer
+    void publish(){
+        if(mode == handoffMode::tripleBuffer){
+            seq[writeIdx] = ++published;
+            std::uint8_t old = latest.exchange(static_cast<std::uint8_t>(writeIdx | kFresh),
+                                               std::memory_order_acq_rel);
+            writeIdx = old & 3;
+            return;
+        }
+        std::lock_guard<std::mutex> lock(m);
+        if(writeIdx == kNone){
+            throw std::logic_error("pingPongBuffer: publish without acquire_write");
+        }
+        seq[writeIdx] = ++published;
+        state[writeIdx] = kReady;
+        writeIdx = kNone;
+        cv.notify_all();
+    }
+
+    // the next frame to read (doubleBuffer) or the latest one (tripleBuffer); see above
+    // for when it is nullptr
+    ::queue<T>* acquire_read(){
+        if(mode == handoffMode::tripleBuffer){
+            if(latest.load(std::memory_order_relaxed) & kFresh){
+                std::uint8_t old = latest.exchange(static_cast<std::uint8_t>(readIdx), std::memory_order_acq_rel);
+                readIdx = old & 3;
+            }
+            readSeq = seq[readIdx];
+            return readSeq == 0 ? nullptr : &frames[readIdx];
+        }
+        std::unique_lock<std::mutex> lock(m);
+        if(readIdx != kNone){
+            throw std::logic_error("pingPongBuffer: previous frame not released");
+        }
+        cv.wait(lock, [&]{ return state[0] == kReady || state[1] == kReady || closed; });
+        if(state[0] != kReady && state[1] != kReady){
+            return nullptr;
+        }
+        if(state[0] == kReady && state[1] == kReady){
+            readIdx = seq[0] < seq[1] ? 0 : 1;
+        }
+        else{
+            readIdx = state[0] == kReady ? 0 : 1;
+        }
+        state[readIdx] = kReading;
+        readSeq = seq[readIdx];
+        return &frames[readIdx];
+    }
+
+    // gives the frame from acquire_read() back to the producer
+    void release(){
+        if(mode == handoffMode::tripleBuffer){
+            return;
+        }
+        std::lock_guard<std::mutex> lock(m);
+        if(readIdx == kNone){
+            throw std::logic_error("pingPongBuffer: release without acquire_read");
+        }
+        state[readIdx] = kFree;
+        readIdx = kNone;
+        cv.notify_all();
+    }
+
+    // doubleBuffer: no more frames; the reader drains what was published and a producer
+    // waiting in acquire_write() throws. tripleBuffer never waits and ignores close()
+    void close(){
+        std::lock_guard<std::mutex> lock(m);
+        closed = true;
+        cv.notify_all();
+    }
+
+    // publish number (from 1) of the frame last returned by acquire_read()
+    std::uint64_t readSequence() const{
+        return readSeq;
+    }
+
+    handoffMode handoff() const{
+        return mode;
+    }
+};
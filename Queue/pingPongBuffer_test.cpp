@@ -0,0 +1,269 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+
+// 包含你的pingPongBuffer實現，以及作為基準的mpmcRing
+#include "pingPongBuffer.cpp"
+#include "mpmcRing.cpp"
+
+// 測試計數器
+int tests_passed = 0;
+int tests_total = 0;
+
+// 測試輔助宏
+#define TEST(name) \
+    void test_##name(); \
+    void run_test_##name() { \
+        tests_total++; \
+        std::cout << "Testing " #name "... "; \
+        try { \
+            test_##name(); \
+            tests_passed++; \
+            std::cout << "PASSED\n"; \
+        } catch (const std::exception& e) { \
+            std::cout << "FAILED: " << e.what() << "\n"; \
+        } catch (...) { \
+            std::cout << "FAILED: Unknown exception\n"; \
+        } \
+    } \
+    void test_##name()
+
+// ============= 基本功能測試 =============
+
+TEST(double_buffer_every_frame_in_order) {
+    const int FRAMES = 2000, PER = 100;
+    pingPongBuffer<int> pp(PER);
+    std::thread producer([&] {
+        for (int f = 0; f < FRAMES; f++) {
+            ::queue<int>& frame = pp.acquire_write();
+            assert(frame.empty());  // 拿到的frame已經清空
+            for (int i = 0; i < PER; i++) frame.enqueue(f * PER + i);
+            pp.publish();
+        }
+        pp.close();
+    });
+
+    int expected = 0;
+    while (::queue<int>* frame = pp.acquire_read()) {
+        assert(pp.readSequence() == std::uint64_t(expected / PER + 1));
+        assert(frame->size() == PER);
+        while (!frame->empty()) {
+            assert(frame->front() == expected++);
+            frame->dequeue();
+        }
+        pp.release();
+    }
+    producer.join();
+    assert(expected == FRAMES * PER);
+    assert(pp.acquire_read() == nullptr);  // 關閉之後一直是nullptr
+}
+
+TEST(frames_are_reused) {
+    pingPongBuffer<std::string> pp(8);
+    for (int f = 0; f < 100; f++) {
+        ::queue<std::string>& frame = pp.acquire_write();
+        for (int i = 0; i < 8; i++) frame.enqueue(std::to_string(f));
+        assert(frame.capacity() == 8);  // 一直是同一塊儲存空間，不會重新配置
+        pp.publish();
+        ::queue<std::string>* r = pp.acquire_read();
+        assert(r == &frame && r->back() == std::to_string(f));
+        pp.release();
+    }
+}
+
+TEST(protocol_misuse) {
+    pingPongBuffer<int> pp(4);
+    try {
+        pp.publish();
+        assert(false);
+    } catch (const std::logic_error&) {
+        // 預期的異常
+    }
+    try {
+        pp.release();
+        assert(false);
+    } catch (const std::logic_error&) {
+        // 預期的異常
+    }
+    pp.acquire_write();
+    try {
+        pp.acquire_write();
+        assert(false);
+    } catch (const std::logic_error&) {
+        // 預期的異常
+    }
+    pp.publish();
+    pp.acquire_read();
+    try {
+        pp.acquire_read();
+        assert(false);
+    } catch (const std::logic_error&) {
+        // 預期的異常
+    }
+    pp.release();
+    pp.close();
+    try {
+        pp.acquire_write();
+        assert(false);
+    } catch (const std::logic_error&) {
+        // 預期的異常
+    }
+}
+
+TEST(close_wakes_blocked_producer) {
+    pingPongBuffer<int> pp(4);
+    for (int f = 0; f < 2; f++) {  // 兩個frame都發佈了，consumer卻不再讀
+        pp.acquire_write().enqueue(f);
+        pp.publish();
+    }
+    std::atomic<bool> threw{false};
+    std::thread producer([&] {
+        try {
+            pp.acquire_write();  // 等不到空的frame
+        } catch (const std::logic_error&) {
+            threw.store(true);  // 預期的異常
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    pp.close();
+    producer.join();  // close()之後不會卡住
+    assert(threw.load());
+}
+
+TEST(triple_buffer_latest_value) {
+    pingPongBuffer<int> pp(4, handoffMode::tripleBuffer);
+    assert(pp.acquire_read() == nullptr);  // 還沒有任何frame
+    for (int f = 1; f <= 3; f++) {
+        pp.acquire_write().enqueue(f);
+        pp.publish();  // 寫入端永遠不等待
+    }
+    ::queue<int>* r = pp.acquire_read();
+    assert(r != nullptr && r->front() == 3 && pp.readSequence() == 3);  // 1和2被跳過
+    assert(pp.acquire_read() == r && pp.readSequence() == 3);          // 沒有新的就還是同一個
+    pp.acquire_write().enqueue(4);
+    pp.publish();
+    r = pp.acquire_read();
+    assert(r->front() == 4 && pp.readSequence() == 4);
+    pp.release();  // no-op
+}
+
+TEST(triple_buffer_frames_never_torn) {
+    const int FRAMES = 200000, PER = 16;
+    pingPongBuffer<std::uint64_t> pp(PER, handoffMode::tripleBuffer);
+    std::atomic<bool> done{false};
+    std::thread producer([&] {
+        for (std::uint64_t f = 1; f <= FRAMES; f++) {
+            ::queue<std::uint64_t>& frame = pp.acquire_write();
+            for (int i = 0; i < PER; i++) frame.enqueue(f);
+            pp.publish();
+        }
+        done.store(true);
+    });
+
+    std::uint64_t last = 0, distinct = 0;
+    for (;;) {
+        bool finished = done.load();
+        if (::queue<std::uint64_t>* frame = pp.acquire_read()) {
+            std::uint64_t s = pp.readSequence();
+            assert(s >= last);  // 序號不會倒退
+            assert(frame->size() == PER && frame->front() == s && frame->back() == s);  // 整個frame同一版
+            distinct += s != last;
+            last = s;
+        }
+        if (finished) break;
+        std::this_thread::yield();
+    }
+    producer.join();
+    assert(last == FRAMES);  // 最後一定看到最新的
+    assert(distinct >= 1);
+}
+
+// ============= 性能測試 =============
+
+TEST(frame_handoff_vs_per_element_spsc) {
+    const int FRAMES = 4000, PER = 4096;
+    const std::uint64_t expect = std::uint64_t(FRAMES) * PER * (std::uint64_t(FRAMES) * PER - 1) / 2;
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::uint64_t sum = 0;
+    {
+        pingPongBuffer<std::uint32_t> pp(PER);
+        std::thread producer([&] {
+            std::uint32_t v = 0;
+            for (int f = 0; f < FRAMES; f++) {
+                ::queue<std::uint32_t>& frame = pp.acquire_write();
+                for (int i = 0; i < PER; i++) frame.enqueue(v++);
+                pp.publish();
+            }
+            pp.close();
+        });
+        while (::queue<std::uint32_t>* frame = pp.acquire_read()) {
+            while (!frame->empty()) {
+                sum += frame->front();
+                frame->dequeue();
+            }
+            pp.release();
+        }
+        producer.join();
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    assert(sum == expect);
+
+    sum = 0;
+    {
+        mpmcRing<std::uint32_t> ring(2 * PER);
+        std::thread producer([&] {
+            for (std::uint32_t v = 0; v < std::uint32_t(FRAMES) * PER; v++) {
+                while (!ring.tryEnqueue(v)) std::this_thread::yield();
+            }
+        });
+        std::uint32_t x;
+        for (std::uint64_t n = 0; n < std::uint64_t(FRAMES) * PER; n++) {
+            while (!ring.tryDequeue(x)) std::this_thread::yield();
+            sum += x;
+        }
+        producer.join();
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    assert(sum == expect);
+
+    double items = double(FRAMES) * PER;
+    std::cout << "\n  (" << std::thread::hardware_concurrency() << " hardware threads) " << FRAMES << " frames x "
+              << PER << ": double buffer " << items / std::chrono::duration<double>(t1 - t0).count() / 1e6
+              << " M items/s, per-element mpmcRing "
+              << items / std::chrono::duration<double>(t2 - t1).count() / 1e6 << " M items/s ";
+}
+
+// ============= 主測試函數 =============
+
+int main() {
+    std::cout << "=== PingPongBuffer 測試套件 ===\n\n";
+
+    // 運行所有測試
+    run_test_double_buffer_every_frame_in_order();
+    run_test_frames_are_reused();
+    run_test_protocol_misuse();
+    run_test_close_wakes_blocked_producer();
+    run_test_triple_buffer_latest_value();
+    run_test_triple_buffer_frames_never_torn();
+    run_test_frame_handoff_vs_per_element_spsc();
+
+    // 測試結果
+    std::cout << "\n=== 測試結果 ===\n";
+    std::cout << "通過: " << tests_passed << "/" << tests_total << " 測試\n";
+
+    if (tests_passed == tests_total) {
+        std::cout << "🎉 所有測試通過！\n";
+        return 0;
+    } else {
+        std::cout << "❌ 有 " << (tests_total - tests_passed) << " 個測試失敗\n";
+        return 1;
+    }
+}
@@ -0,0 +1,510 @@
+#include <iostream>
+#include <utility>
+#include <stdexcept>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <type_traits>
+#include <cstdint>
+
+#include "mpmcRing.cpp"
+
+// ordered: a parallel stage emits its batches in input order (workers may still run
+//          the function out of order); a parallel sink calls its function in order
+// unordered: whichever worker finishes first goes first
+enum class stageOrder { ordered, unordered };
+
+// per-stage counters, see pipeline::stats()
+struct stageStats{
+    std::string name;
+    std::size_t workers;
+    std::uint64_t items;
+    std::uint64_t batches;
+    double seconds;             // first batch taken to last batch handed on
+    double itemsPerSecond;
+    std::size_t inputDepth;     // batches waiting in the input ring right now
+    std::size_t maxInputDepth;  // highest depth a worker saw when taking a batch
+    double blockedSeconds;      // waiting for room downstream or for its turn (ordered), all workers
+    double starvedSeconds;      // waiting for input, all workers
+};
+
+namespace pipelineDetail{
+
+// unit of transfer between stages: one ring slot carries a whole batch, so the ring
+// cost is paid once per batch instead of once per item
+template <typename T>
+struct batch{
+    std::uint64_t seq = 0;
+    std::vector<T> items;
+};
+
+struct linkBase{
+    bool consumed = false;      // a ring feeds exactly one stage
+    virtual ~linkBase(){}
+};
+
+template <typename T>
+struct link : linkBase{
+    mpmcRing<batch<T>> ring;
+    std::atomic<bool> closed{false};
+
+    explicit link(std::size_t cap) : ring(cap){}
+};
+
+inline std::int64_t nowNs(){
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// yield first, then back off to short sleeps so an idle stage does not burn a core
+inline void backoff(unsigned& spins){
+    if(++spins < 64){
+        std::this_thread::yield();
+    }
+    else{
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+}
+
+class stageBase
+{
+public:
+    std::string name;
+    std::size_t workers;
+    std::vector<std::thread> threads;
+    std::atomic<std::uint64_t> items{0};
+    std::atomic<std::uint64_t> batches{0};
+    std::atomic<std::int64_t> firstNs{0};
+    std::atomic<std::int64_t> lastNs{0};
+    std::atomic<std::size_t> maxDepth{0};
+    std::atomic<std::int64_t> blockedNs{0};
+    std::atomic<std::int64_t> starvedNs{0};
+
+    stageBase(std::string name, std::size_t workers) : name(std::move(name)), workers(workers){}
+    virtual ~stageBase(){}
+
+    virtual std::size_t inputDepth() const = 0;
+
+    void join(){
+        for(auto& t : threads){
+            if(t.joinable()){
+                t.join();
+            }
+        }
+    }
+};
+
+// shared by every stage of one pipeline: stages, the rings between them, the first failure
+struct core{
+    std::vector<std::unique_ptr<stageBase>> stages;
+    std::vector<std::unique_ptr<linkBase>> links;
+    std::size_t ringCapacity;
+    std::size_t batchSize;
+    std::atomic<bool> aborted{false};
+    std::atomic<bool> errorSet{false};
+    std::exception_ptr error;
+
+    // only the first failure is kept; aborted is published after error is written, so
+    // whoever acquire-loads aborted as true may read error
+    void fail(std::exception_ptr e){
+        if(errorSet.exchange(true, std::memory_order_acq_rel)){
+            return;
+        }
+        error = e;
+        aborted.store(true, std::memory_order_release);
+    }
+};
+
+// In -> Out map stage, or a sink when Out is void
+template <typename In, typename Out, typename Fn>
+class stage : public stageBase
+{
+private:
+    core& owner;
+    link<In>& in;
+    link<Out>* out;             // nullptr for a sink
+    Fn fn;
+    stageOrder order;
+    std::atomic<std::uint64_t> nextSeq{0};  // ordered: next batch allowed to go on
+    std::atomic<bool> emitLock{false};      // unordered: numbering + enqueue as one step
+    std::atomic<std::size_t> active;
+
+    // false if the pipeline was aborted meanwhile
+    bool waitTurn(std::uint64_t seq){
+        if(order == stageOrder::unordered || workers == 1){
+            return true;
+        }
+        if(nextSeq.load(std::memory_order_acquire) == seq){
+            return true;
+        }
+        std::int64_t t0 = nowNs();
+        unsigned spins = 0;
+        while(nextSeq.load(std::memory_order_acquire) != seq){
+            if(owner.aborted.load(std::memory_order_relaxed)){
+                return false;
+            }
+            backoff(spins);
+        }
+        blockedNs.fetch_add(nowNs() - t0, std::memory_order_relaxed);
+        return true;
+    }
+
+    void passTurn(){
+        if(order == stageOrder::ordered && workers > 1){
+            nextSeq.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+    bool emit(batch<Out>& b){
+        if(out->ring.tryEnqueue(std::move(b))){
+            return true;
+        }
+        std::int64_t t0 = nowNs();
+        unsigned spins = 0;
+        while(!out->ring.tryEnqueue(std::move(b))){
+            if(owner.aborted.load(std::memory_order_relaxed)){
+                return false;
+            }
+            backoff(spins);
+        }
+        blockedNs.fetch_add(nowNs() - t0, std::memory_order_relaxed);
+        return true;
+    }
+
+    // the whole batch: map into a new batch and hand it on, or feed the sink
+    template <typename O = Out>
+    typename std::enable_if<!std::is_void<O>::value, bool>::type process(batch<In>& b){
+        batch<Out> result;
+        result.items.reserve(b.items.size());
+        for(In& v : b.items){
+            result.items.push_back(fn(std::move(v)));
+        }
+        if(order == stageOrder::ordered){
+            if(!waitTurn(b.seq)){
+                return false;
+            }
+            result.seq = b.seq;
+            bool ok = emit(result);
+            passTurn();
+            return ok;
+        }
+        // unordered renumbers in emit order, so the next stage still receives
+        // consecutive sequence numbers in ring order
+        unsigned spins = 0;
+        while(emitLock.exchange(true, std::memory_order_acquire)){
+            backoff(spins);
+        }
+        result.seq = nextSeq.fetch_add(1, std::memory_order_relaxed);
+        bool ok = emit(result);
+        emitLock.store(false, std::memory_order_release);
+        return ok;
+    }
+
+    template <typename O = Out>
+    typename std::enable_if<std::is_void<O>::value, bool>::type process(batch<In>& b){
+        if(!waitTurn(b.seq)){
+            return false;
+        }
+        for(In& v : b.items){
+            fn(std::move(v));
+        }
+        passTurn();
+        return true;
+    }
+
+    void workerLoop(){
+        unsigned spins = 0;
+        std::int64_t idleSince = 0;
+        try
+        {
+            while(!owner.aborted.load(std::memory_order_relaxed)){
+                batch<In> b;
+                if(!in.ring.tryDequeue(b)){
+                    // closed is set after the last enqueue, so one more look settles it
+                    if(!in.closed.load(std::memory_order_acquire)){
+                        if(idleSince == 0){
+                            idleSince = nowNs();
+                        }
+                        backoff(spins);
+                        continue;
+                    }
+                    if(!in.ring.tryDequeue(b)){
+                        break;
+                    }
+                }
+                spins = 0;
+                std::int64_t t = nowNs();
+                if(idleSince != 0){
+                    starvedNs.fetch_add(t - idleSince, std::memory_order_relaxed);
+                    idleSince = 0;
+                }
+                std::int64_t zero = 0;
+                firstNs.compare_exchange_strong(zero, t, std::memory_order_relaxed);
+
+                std::size_t depth = in.ring.size();
+                std::size_t m = maxDepth.load(std::memory_order_relaxed);
+                while(depth > m && !maxDepth.compare_exchange_weak(m, depth, std::memory_order_relaxed)){
+                }
+
+                std::size_t n = b.items.size();
+                if(!process(b)){
+                    break;
+                }
+                items.fetch_add(n, std::memory_order_relaxed);
+                batches.fetch_add(1, std::memory_order_relaxed);
+                lastNs.store(nowNs(), std::memory_order_relaxed);
+            }
+        }
+        catch(...)
+        {
+            owner.fail(std::current_exception());
+        }
+        if(active.fetch_sub(1, std::memory_order_acq_rel) == 1 && out != nullptr){
+            out->closed.store(true, std::memory_order_release);
+        }
+    }
+
+public:
+    stage(core& owner, std::string name, link<In>& in, link<Out>* out, Fn fn,
+          std::size_t workers, stageOrder order)
+        : stageBase(std::move(name), workers), owner(owner), in(in), out(out),
+          fn(std::move(fn)), order(order), active(workers){}
+
+    void start(){
+        for(std::size_t i = 0; i < workers; i++){
+            threads.emplace_back(&stage::workerLoop, this);
+        }
+    }
+
+    std::size_t inputDepth() const override{
+        return in.ring.size();
+    }
+};
+
+}
+
+// builder handle for the open end of a pipeline whose last stage produces T
+template <typename T>
+class pipelineStage
+{
+private:
+    pipelineDetail::core& owner;
+    pipelineDetail::link<T>& tail;
+
+    void claimTail(std::size_t workers){
+        if(workers == 0){
+            throw std::invalid_argument("pipeline stage needs at least one worker");
+        }
+        if(tail.consumed){
+            throw std::logic_error("pipeline stage output is already connected");
+        }
+        tail.consumed = true;
+    }
+
+public:
+    pipelineStage(pipelineDetail::core& owner, pipelineDetail::link<T>& tail) : owner(owner), tail(tail){}
+
+    // add a T -> Out stage; fn is called once per item
+    template <typename Fn>
+    auto then(std::string name, Fn fn, std::size_t workers = 1, stageOrder order = stageOrder::ordered)
+        -> pipelineStage<typename std::decay<decltype(fn(std::declval<T&&>()))>::type>{
+        typedef typename std::decay<decltype(fn(std::declval<T&&>()))>::type Out;
+        static_assert(!std::is_void<Out>::value, "a stage returning void is a sink, use sink()");
+        claimTail(workers);
+        pipelineDetail::link<Out>* out = new pipelineDetail::link<Out>(owner.ringCapacity);
+        owner.links.emplace_back(out);
+        auto* s = new pipelineDetail::stage<T, Out, Fn>(owner, std::move(name), tail, out,
+                                                         std::move(fn), workers, order);
+        owner.stages.emplace_back(s);
+        s->start();
+        return pipelineStage<Out>(owner, *out);
+    }
+
+    // terminate the pipeline; fn consumes each item
+    template <typename Fn>
+    void sink(std::string name, Fn fn, std::size_t workers = 1, stageOrder order = stageOrder::ordered){
+        claimTail(workers);
+        auto* s = new pipelineDetail::stage<T, void, Fn>(owner, std::move(name), tail, nullptr,
+                                                          std::move(fn), workers, order);
+        owner.stages.emplace_back(s);
+        s->start();
+    }
+};
+
+// Pipeline of stages, each on its own worker thread(s), connected by bounded mpmcRings.
+// Items travel in batches of batchSize; a stage whose output ring is full waits, so a
+// slow stage throttles everything upstream of it (backpressure) instead of letting
+// queues grow without bound. A stage with several workers is either ordered (batches
+// leave in the order they came in) or unordered.
+//
+//     pipeline<std::string> p;
+//     p.then("parse", parseLine)
+//      .then("enrich", enrich, 4, stageOrder::unordered)
+//      .sink("write", writeRecord);
+//     for(...) p.push(line);
+//     p.finish();                 // drains, joins, rethrows the first stage failure
+//
+// Stages start as soon as they are added. An exception thrown by a stage function
+// aborts the pipeline: push() then throws and finish() rethrows it.
+template <typename In>
+class pipeline
+{
+private:
+    pipelineDetail::core owner;
+    pipelineDetail::link<In>* head;
+    pipelineDetail::batch<In> pending;
+    std::uint64_t nextSeq = 0;
+    bool finished = false;
+    std::int64_t sourceBlockedNs = 0;
+
+    void checkAborted(){
+        if(owner.aborted.load(std::memory_order_acquire)){
+            std::rethrow_exception(owner.error);
+        }
+    }
+
+    void sendPending(){
+        if(pending.items.empty()){
+            return;
+        }
+        pending.seq = nextSeq;
+        if(!head->ring.tryEnqueue(std::move(pending))){
+            std::int64_t t0 = pipelineDetail::nowNs();
+            unsigned spins = 0;
+            while(!head->ring.tryEnqueue(std::move(pending))){
+                checkAborted();
+                pipelineDetail::backoff(spins);
+            }
+            sourceBlockedNs += pipelineDetail::nowNs() - t0;
+        }
+        nextSeq++;
+        pending.items.clear();
+        pending.items.reserve(owner.batchSize);
+    }
+
+public:
+    // ctor, ringCapacity counts batches per ring (rounded up to a power of two)
+    explicit pipeline(std::size_t ringCapacity = 64, std::size_t batchSize = 64){
+        if(batchSize == 0){
+            throw std::invalid_argument("pipeline batch size must be positive");
+        }
+        owner.ringCapacity = ringCapacity;
+        owner.batchSize = batchSize;
+        head = new pipelineDetail::link<In>(ringCapacity);
+        owner.links.emplace_back(head);
+        pending.items.reserve(batchSize);
+    }
+
+    pipeline(const pipeline&) = delete;
+    pipeline& operator=(const pipeline&) = delete;
+
+    // destructor, a failure nobody collected through finish() is dropped
+    ~pipeline(){
+        try
+        {
+            finish();
+        }
+        catch(...)
+        {
+        }
+    }
+
+    template <typename Fn>
+    auto then(std::string name, Fn fn, std::size_t workers = 1, stageOrder order = stageOrder::ordered){
+        return pipelineStage<In>(owner, *head).then(std::move(name), std::move(fn), workers, order);
+    }
+
+    template <typename Fn>
+    void sink(std::string name, Fn fn, std::size_t workers = 1, stageOrder order = stageOrder::ordered){
+        pipelineStage<In>(owner, *head).sink(std::move(name), std::move(fn), workers, order);
+    }
+
+    // blocks while the first ring is full
+    void push(const In& value){
+        checkAborted();
+        pending.items.push_back(value);
+        if(pending.items.size() >= owner.batchSize){
+            sendPending();
+        }
+    }
+
+    void push(In&& value){
+        checkAborted();
+        pending.items.push_back(std::move(value));
+        if(pending.items.size() >= owner.batchSize){
+            sendPending();
+        }
+    }
+
+    // send a partly filled batch now
+    void flush(){
+        checkAborted();
+        sendPending();
+    }
+
+    // flush, close the input and wait until every stage has drained
+    void finish(){
+        if(finished){
+            return;
+        }
+        finished = true;
+        for(const auto& l : owner.links){
+            if(!l->consumed){
+                // nothing would ever drain that ring; stop the stages instead of hanging
+                owner.fail(std::make_exception_ptr(std::logic_error("pipeline has no sink")));
+            }
+        }
+        if(!owner.aborted.load(std::memory_order_acquire)){
+            try
+            {
+                sendPending();
+            }
+            catch(...)
+            {
+            }
+        }
+        head->closed.store(true, std::memory_order_release);
+        for(auto& s : owner.stages){
+            s->join();
+        }
+        checkAborted();
+    }
+
+    std::vector<stageStats> stats() const{
+        std::vector<stageStats> out;
+        for(const auto& s : owner.stages){
+            stageStats st;
+            st.name = s->name;
+            st.workers = s->workers;
+            st.items = s->items.load(std::memory_order_relaxed);
+            st.batches = s->batches.load(std::memory_order_relaxed);
+            std::int64_t span = s->lastNs.load(std::memory_order_relaxed) - s->firstNs.load(std::memory_order_relaxed);
+            st.seconds = span > 0 ? span / 1e9 : 0.0;
+            st.itemsPerSecond = st.seconds > 0 ? st.items / st.seconds : 0.0;
+            st.inputDepth = s->inputDepth();
+            st.maxInputDepth = s->maxDepth.load(std::memory_order_relaxed);
+            st.blockedSeconds = s->blockedNs.load(std::memory_order_relaxed) / 1e9;
+            st.starvedSeconds = s->starvedNs.load(std::memory_order_relaxed) / 1e9;
+            out.push_back(st);
+        }
+        return out;
+    }
+
+    // time push() spent waiting for room in the first ring; call from the pushing thread
+    double sourceBlockedSeconds() const{
+        return sourceBlockedNs / 1e9;
+    }
+
+    void printStats() const{
+        for(const stageStats& st : stats()){
+            std::cout << st.name << " x" << st.workers << ": " << st.items << " items in " << st.batches
+                      << " batches, " << st.itemsPerSecond << " items/s, depth " << st.inputDepth
+                      << " (max " << st.maxInputDepth << "), blocked " << st.blockedSeconds
+                      << "s, starved " << st.starvedSeconds << "s" << std::endl;
+        }
+    }
+};
@@ -0,0 +1,266 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <cstdint>
+
+// 包含你的pipeline實現
+#include "pipeline.cpp"
+
+// 測試計數器
+int tests_passed = 0;
+int tests_total = 0;
+
+// 測試輔助宏
+#define TEST(name) \
+    void test_##name(); \
+    void run_test_##name() { \
+        tests_total++; \
+        std::cout << "Testing " #name "... "; \
+        try { \
+            test_##name(); \
+            tests_passed++; \
+            std::cout << "PASSED\n"; \
+        } catch (const std::exception& e) { \
+            std::cout << "FAILED: " << e.what() << "\n"; \
+        } catch (...) { \
+            std::cout << "FAILED: Unknown exception\n"; \
+        } \
+    } \
+    void test_##name()
+
+// 輔助函數：不會被優化掉的CPU工作量
+static std::uint64_t mix(std::uint64_t x, int rounds) {
+    for (int i = 0; i < rounds; i++) {
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+    }
+    return x;
+}
+
+// ============= 基本功能測試 =============
+
+TEST(sequential_chain_keeps_order) {
+    std::vector<int> out;
+    pipeline<std::string> p(4, 8);
+    p.then("parse", [](std::string s) { return std::stoi(s); })
+     .then("double", [](int v) { return v * 2; })
+     .sink("collect", [&](int v) { out.push_back(v); });
+
+    for (int i = 0; i < 1000; i++) p.push(std::to_string(i));
+    p.finish();
+
+    assert(out.size() == 1000);
+    for (int i = 0; i < 1000; i++) assert(out[i] == 2 * i);
+
+    auto st = p.stats();
+    assert(st.size() == 3);
+    assert(st[0].name == "parse" && st[2].name == "collect");
+    for (const auto& s : st) {
+        assert(s.items == 1000);
+        assert(s.batches == 125);  // 1000 / 8
+        assert(s.inputDepth == 0);
+    }
+}
+
+TEST(parallel_ordered_and_unordered) {
+    // 工作量隨值變化，讓worker完成的順序被打亂
+    auto work = [](int v) { return static_cast<int>(mix(v, 1 + v % 50) % 1000) + v * 1000; };
+
+    std::vector<int> ordered;
+    {
+        pipeline<int> p(8, 4);
+        p.then("work", work, 4, stageOrder::ordered)
+         .sink("collect", [&](int v) { ordered.push_back(v); });
+        for (int i = 0; i < 5000; i++) p.push(i);
+        p.finish();
+    }
+    assert(ordered.size() == 5000);
+    for (int i = 0; i < 5000; i++) assert(ordered[i] / 1000 == i);
+
+    std::vector<int> unordered;
+    std::mutex m;
+    {
+        pipeline<int> p(8, 4);
+        p.then("work", work, 4, stageOrder::unordered)
+         .then("id", [](int v) { return v; }, 2, stageOrder::ordered)  // 亂序輸出之後接有序的平行stage
+         .sink("collect", [&](int v) { std::lock_guard<std::mutex> lock(m); unordered.push_back(v); },
+               2, stageOrder::unordered);
+        for (int i = 0; i < 5000; i++) p.push(i);
+        p.finish();
+    }
+    std::sort(unordered.begin(), unordered.end());
+    assert(unordered == ordered);  // 順序不同，內容相同
+}
+
+TEST(backpressure_bounds_queues) {
+    pipeline<int> p(2, 1);  // 每個ring只有2個batch，每個batch 1個item
+    p.then("fast", [](int v) { return v; })
+     .sink("slow", [](int) { std::this_thread::sleep_for(std::chrono::microseconds(200)); });
+    for (int i = 0; i < 300; i++) p.push(i);
+    p.finish();
+
+    auto st = p.stats();
+    assert(st[1].items == 300);
+    assert(st[0].maxInputDepth <= 2 && st[1].maxInputDepth <= 2);
+    assert(st[0].blockedSeconds > 0.0);    // fast被slow擋住
+    assert(p.sourceBlockedSeconds() > 0.0); // 最後連push也被擋住
+}
+
+TEST(failures_propagate) {
+    pipeline<int> p(4, 16);
+    p.then("check", [](int v) {
+        if (v == 500) throw std::runtime_error("bad record");
+        return v;
+    }).sink("drop", [](int) {});
+
+    bool thrown = false;
+    try {
+        for (int i = 0; i < 100000; i++) p.push(i);
+        p.finish();
+    } catch (const std::runtime_error& e) {
+        thrown = std::string(e.what()) == "bad record";
+    }
+    assert(thrown);
+
+    pipeline<int> q;
+    auto tail = q.then("a", [](int v) { return v; });
+    tail.sink("b", [](int) {});
+    try {
+        tail.sink("c", [](int) {});  // 同一個輸出不能接兩個stage
+        assert(false);
+    } catch (const std::logic_error&) {
+        // 預期的異常
+    }
+    try {
+        q.then("d", [](int v) { return v; }, 0);
+        assert(false);
+    } catch (const std::invalid_argument&) {
+        // 預期的異常
+    }
+    q.finish();
+
+    pipeline<int> open;
+    open.then("no sink", [](int v) { return v; });
+    try {
+        open.finish();
+        assert(false);
+    } catch (const std::logic_error&) {
+        // 預期的異常
+    }
+}
+
+TEST(concurrent_failures_keep_one_error) {
+    // 兩個stage(各有多個worker)幾乎同時拋出，拿到的一定是其中一個完整的異常
+    for (int round = 0; round < 200; round++) {
+        pipeline<int> p(4, 1);
+        p.then("odd", [](int v) {
+            if (v % 2 == 1) throw std::runtime_error("odd");
+            return v;
+        }, 2, stageOrder::unordered).sink("even", [](int v) {
+            if (v % 2 == 0) throw std::runtime_error("even");
+        }, 2, stageOrder::unordered);
+
+        std::string what;
+        try {
+            for (int i = 0; i < 100000; i++) p.push(i);
+            p.finish();
+        } catch (const std::runtime_error& e) {
+            what = e.what();
+        }
+        assert(what == "odd" || what == "even");
+    }
+}
+
+// ============= 性能測試 =============
+
+struct record {
+    std::uint64_t a, b, c;
+};
+
+static record parseRecord(const std::string& line) {
+    record r;
+    std::size_t p1 = line.find(','), p2 = line.find(',', p1 + 1);
+    r.a = std::stoull(line.substr(0, p1));
+    r.b = std::stoull(line.substr(p1 + 1, p2 - p1 - 1));
+    r.c = std::stoull(line.substr(p2 + 1));
+    return r;
+}
+
+TEST(four_stages_vs_sequential) {
+    const int N = 200000, ROUNDS = 40;
+    std::vector<std::string> lines;
+    lines.reserve(N);
+    for (int i = 0; i < N; i++) lines.push_back(std::to_string(i) + "," + std::to_string(i * 7) + "," + std::to_string(i % 13));
+
+    auto transform = [&](record r) { r.b = mix(r.a ^ r.b, ROUNDS); return r; };
+    auto score = [&](record r) { return mix(r.b + r.c, ROUNDS); };
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::uint64_t seqSum = 0;
+    for (const auto& l : lines) seqSum += score(transform(parseRecord(l)));
+    auto t1 = std::chrono::steady_clock::now();
+
+    auto runPipeline = [&](std::size_t workers, stageOrder order) {
+        std::uint64_t sum = 0;
+        pipeline<std::string> p(64, 256);
+        p.then("parse", parseRecord)
+         .then("transform", transform, workers, order)
+         .then("score", score, workers, order)
+         .sink("write", [&](std::uint64_t v) { sum += v; });
+        auto s = std::chrono::steady_clock::now();
+        for (const auto& l : lines) p.push(l);
+        p.finish();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - s).count();
+        assert(sum == seqSum);
+        return std::make_pair(ms, p.stats());
+    };
+
+    auto one = runPipeline(1, stageOrder::ordered);
+    auto par = runPipeline(2, stageOrder::unordered);
+    double seqMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+
+    std::cout << "\n  (" << std::thread::hardware_concurrency() << " hardware threads) " << N << " records: sequential "
+              << seqMs << "ms, pipeline " << one.first << "ms, pipeline with 2 workers on transform/score "
+              << par.first << "ms";
+    for (const auto& s : one.second) {
+        std::cout << "\n    " << s.name << ": " << s.itemsPerSecond / 1e6 << " M items/s, max depth "
+                  << s.maxInputDepth << ", blocked " << s.blockedSeconds * 1e3 << "ms, starved "
+                  << s.starvedSeconds * 1e3 << "ms";
+    }
+    std::cout << " ";
+}
+
+// ============= 主測試函數 =============
+
+int main() {
+    std::cout << "=== Pipeline 測試套件 ===\n\n";
+
+    // 運行所有測試
+    run_test_sequential_chain_keeps_order();
+    run_test_parallel_ordered_and_unordered();
+    run_test_backpressure_bounds_queues();
+    run_test_failures_propagate();
+    run_test_concurrent_failures_keep_one_error();
+    run_test_four_stages_vs_sequential();
+
+    // 測試結果
+    std::cout << "\n=== 測試結果 ===\n";
+    std::cout << "通過: " << tests_passed << "/" << tests_total << " 測試\n";
+
+    if (tests_passed == tests_total) {
+        std::cout << "🎉 所有測試通過！\n";
+        return 0;
+    } else {
+        std::cout << "❌ 有 " << (tests_total - tests_passed) << " 個測試失敗\n";
+        return 1;
+    }
+}
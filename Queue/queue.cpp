@@ -5,8 +5,11 @@
 #include <type_traits>
 using namespace std;
 
-template <typename T>
-class queue
+#include "../common/containerStats.cpp"
+#include "../common/mappedBuffer.cpp"
+
+template <typename T, typename Stats = defaultStatsRecorder>
+class queue : private Stats
 {
 private:
     T* data;
@@ -14,12 +17,23 @@ private:
     std::size_t frontIdx;
     std::size_t rearIdx;
     double growth = 2.0;
+    std::uint8_t mapFlags = 0;      // how data was allocated, see mappedBuffer.cpp
 
     void resize(size_t newCap){
         if(newCap <= cap){
             return;
         }
-        T* newData = new T[newCap];
+        relocate(newCap, mapFlags);
+        this->recordResize((rearIdx - frontIdx) * sizeof(T));
+    }
+
+    // move the live elements to the start of a fresh buffer allocated according to newFlags
+    void relocate(std::size_t newCap, std::uint8_t newFlags){
+        if(newFlags & mappedBuffer::mapped){
+            // use the whole mapping
+            newCap = mappedBuffer::mappedLength(newCap * sizeof(T), newFlags) / sizeof(T);
+        }
+        T* newData = mappedBuffer::allocate<T>(newCap, newFlags);
         size_t validCount = rearIdx - frontIdx;
         try
         {
@@ -35,24 +49,53 @@ private:
         }
         catch(...)
         {
-            delete [] newData;
+            mappedBuffer::release(newData, newCap, newFlags);
             throw;
         }
 
-        delete [] data;
+        mappedBuffer::release(data, cap, mapFlags);
         rearIdx = validCount;
         frontIdx = 0;
         data = newData;
         cap = newCap;
+        mapFlags = newFlags;
     }
 
     void ensureCapacity(){
         if(rearIdx >= cap){
+            // a long-lived queue that is drained as fast as it is filled would otherwise
+            // keep doubling; when at least half the buffer is dead space in front, slide
+            // the live elements down instead (amortised O(1): the <= cap/2 moves are paid
+            // for by the >= cap/2 dequeues since the last slide)
+            if(frontIdx > 0 && rearIdx - frontIdx <= cap / 2){
+                compact();
+                return;
+            }
             size_t newCap = calculateNewCap();
             resize(newCap);
         }
     }
 
+    // Slide the live elements to the start of the same buffer; counted in
+    // stats().compactions, not as a resize. Only called with rearIdx == cap and at most
+    // cap/2 live elements, so the target [0, validCount) never overlaps the source
+    // [frontIdx, rearIdx): a copy that throws half way leaves every element in place.
+    // The buffer is never replaced, so a reserve()d mapping keeps its prefaulted pages.
+    void compact(){
+        size_t validCount = rearIdx - frontIdx;
+        for(size_t i = 0; i < validCount; i++){
+            if(std::is_nothrow_move_assignable<T>::value){
+                data[i] = std::move(data[i + frontIdx]);
+            }
+            else{
+                data[i] = data[i + frontIdx];
+            }
+        }
+        frontIdx = 0;
+        rearIdx = validCount;
+        this->recordCompaction(validCount * sizeof(T));
+    }
+
     std::size_t calculateNewCap(){
         if(cap == 0){
             return 1;
@@ -66,6 +109,11 @@ private:
     }
 
 public:
+    // occupancy / resize telemetry, see containerStats.cpp
+    using Stats::stats;
+    using Stats::resetStats;
+    using Stats::statsEnabled;
+
     // ctor
     explicit queue(std::size_t cap) : cap(cap), frontIdx(0), rearIdx(0){
         data = new T[cap];
@@ -73,11 +121,13 @@ public:
 
     // destructor
     ~queue()noexcept{
-        delete [] data;
+        mappedBuffer::release(data, cap, mapFlags);
     }
 
     // copy ctor
-    queue(const queue& other) : data(new T[other.cap]), cap(other.cap), frontIdx(other.frontIdx), rearIdx(other.rearIdx){
+    queue(const queue& other)
+    : Stats(other), data(mappedBuffer::allocate<T>(other.cap, other.mapFlags)), cap(other.cap), frontIdx(other.frontIdx),
+      rearIdx(other.rearIdx), mapFlags(other.mapFlags){
         for(size_t i = frontIdx; i < rearIdx; i++){
             data[i] = other.data[i];
         }
@@ -85,10 +135,14 @@ public:
 
     // move ctor
     queue(queue&& other) noexcept
-    : data(std::exchange(other.data, nullptr)),
+    : Stats(),
+      data(std::exchange(other.data, nullptr)),
       cap(std::exchange(other.cap, 0)),
       frontIdx(std::exchange(other.frontIdx, 0)),
-      rearIdx(std::exchange(other.rearIdx, 0)){}
+      rearIdx(std::exchange(other.rearIdx, 0)),
+      mapFlags(std::exchange(other.mapFlags, 0)){
+        this->swapStats(other);
+    }
 
     // copy & move assignment
     queue& operator=(queue other)noexcept{
@@ -101,6 +155,22 @@ public:
         std::swap(cap, other.cap);
         std::swap(frontIdx, other.frontIdx);
         std::swap(rearIdx, other.rearIdx);
+        std::swap(mapFlags, other.mapFlags);
+        this->swapStats(other);
+    }
+
+    // Linux: move into an mmap'ed buffer of at least n elements, 2 MiB aligned with
+    // MADV_HUGEPAGE (huge), mlock'ed (lock) and pre-touched (prefault), so enqueues up
+    // to n never take a page fault. Later growth allocates the same way.
+    void reserve(std::size_t n, bool prefault = true, bool huge = true, bool lock = false){
+        std::uint8_t flags = static_cast<std::uint8_t>(mappedBuffer::mapped |
+            (prefault ? mappedBuffer::prefault : 0) | (huge ? mappedBuffer::huge : 0) |
+            (lock ? mappedBuffer::locked : 0));
+        if(n <= cap - frontIdx && flags == mapFlags){
+            return;
+        }
+        relocate(n > cap ? n : cap, flags);
+        this->recordResize((rearIdx - frontIdx) * sizeof(T));
     }
 
     void enqueue(const T& value){
@@ -110,10 +180,12 @@ public:
         ensureCapacity();
         data[rearIdx] = value;
         rearIdx++;
+        this->recordInsert(rearIdx - frontIdx);
     }
 
     void dequeue(){
         if(rearIdx == frontIdx){
+            this->recordUnderflow();
             throw std::runtime_error("Queue is empty");
         }
         //data[frontIdx].~T();
@@ -122,6 +194,16 @@ public:
 
     const T& front() const{
         if(rearIdx == frontIdx){
+            this->recordUnderflow();
+            throw std::runtime_error("Queue is empty");
+        }
+        return data[frontIdx];
+    }
+
+    // mutable access so the front element can be moved out before dequeue()
+    T& front(){
+        if(rearIdx == frontIdx){
+            this->recordUnderflow();
             throw std::runtime_error("Queue is empty");
         }
         return data[frontIdx];
@@ -129,6 +211,7 @@ public:
 
     const T& back() const{
         if(rearIdx == frontIdx){
+            this->recordUnderflow();
             throw std::runtime_error("Queue is empty");
         }
         return data[rearIdx - 1];
@@ -142,6 +225,10 @@ public:
         return rearIdx - frontIdx;
     }
 
+    size_t capacity() const{
+        return cap;
+    }
+
     void print() const{
         std::cout << "Queue(front -> rear) : ";
         for(std::size_t i = frontIdx; i < rearIdx; i++){
@@ -154,6 +154,75 @@ TEST(resize_with_dequeue) {
     verify_queue_content(q, expected);
 }
 
+TEST(steady_state_does_not_grow) {
+    queue<std::string> q(8);
+    for (int i = 0; i < 4; i++) q.enqueue(std::to_string(i));
+
+    // 一進一出：前面空出來的位置會被回收，而不是一直擴容
+    for (int i = 4; i < 100000; i++) {
+        q.enqueue(std::to_string(i));
+        assert(q.front() == std::to_string(i - 4));
+        q.dequeue();
+    }
+    assert(q.size() == 4);
+    assert(q.capacity() <= 8);
+
+    std::vector<std::string> expected = {"99996", "99997", "99998", "99999"};
+    verify_queue_content(q, expected);
+}
+
+// 賦值會在第budget次拋出異常的型別，queue只能用複製的方式搬它
+struct flakyCopy {
+    static int budget;
+    int v = 0;
+    flakyCopy& operator=(const flakyCopy& o) {
+        if (budget-- == 0) throw std::runtime_error("copy failed");
+        v = o.v;
+        return *this;
+    }
+    bool operator==(const flakyCopy& o) const { return v == o.v; }
+};
+int flakyCopy::budget = std::numeric_limits<int>::max();
+
+TEST(compaction_keeps_elements_when_copy_throws) {
+    queue<flakyCopy> q(8);
+    for (int i = 0; i < 8; i++) q.enqueue(flakyCopy{i});
+    for (int i = 0; i < 6; i++) q.dequeue();
+
+    flakyCopy::budget = 1;  // 往前搬的第二個元素失敗
+    try {
+        q.enqueue(flakyCopy{8});
+        assert(false);
+    } catch (const std::runtime_error&) {
+        // 預期的異常
+    }
+    flakyCopy::budget = std::numeric_limits<int>::max();
+    assert(q.size() == 2 && q.front().v == 6 && q.back().v == 7);  // 原本的元素都還在
+
+    q.enqueue(flakyCopy{8});
+    assert(q.capacity() == 8);
+    verify_queue_content(q, std::vector<flakyCopy>{{6}, {7}, {8}});
+}
+
+TEST(compaction_stays_in_reserved_buffer) {
+    queue<flakyCopy> q(8);  // 不是nothrow的型別也一樣原地搬
+    q.reserve(1 << 12, true, false);
+    std::size_t cap = q.capacity();
+    q.enqueue(flakyCopy{0});
+    const flakyCopy* base = &q.front();
+
+    // 一進一出很多輪：一直在reserve()拿到的那塊mapping裡原地搬，不會重新mmap
+    for (int i = 1; i < int(cap) * 10; i++) {
+        q.enqueue(flakyCopy{i});
+        if (q.size() > 16) {
+            assert(q.front().v == i - 16);
+            q.dequeue();
+        }
+        assert(&q.front() >= base && &q.front() < base + cap);
+    }
+    assert(q.capacity() == cap);
+}
+
 // ============= 拷貝和移動測試 =============
 
 TEST(copy_constructor) {
@@ -414,6 +483,9 @@ int main() {
     run_test_front_and_back_access();
     run_test_dynamic_resizing();
     run_test_resize_with_dequeue();
+    run_test_steady_state_does_not_grow();
+    run_test_compaction_keeps_elements_when_copy_throws();
+    run_test_compaction_stays_in_reserved_buffer();
     run_test_copy_constructor();
     run_test_move_constructor();
     run_test_assignment_operator();
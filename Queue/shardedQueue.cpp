@@ -0,0 +1,222 @@
+#include <iostream>
+#include <utility>
+#include <stdexcept>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <thread>
+#include <limits>
+#include <functional>
+#include <cstdint>
+
+#include "queue.cpp"
+#include "../common/threadIndex.cpp"
+
+// Relaxed k-FIFO queue for many threads: one queue<T> per shard (by default one per
+// hardware thread), each behind a spin lock. enqueue() always appends to the calling
+// thread's own shard, so producers do not share a lock; tryDequeue() takes the front of
+// the local shard, else of one random shard, else of the shard holding the oldest item.
+//
+// Ordering bound: every item gets a ticket from a global counter when it is enqueued,
+// and an item is only handed out if its ticket is within k of floorTicket, a lower
+// bound on the oldest ticket still pending. floorTicket is refreshed (one pass over all
+// shards) only when neither the local nor the random shard qualifies. Hence:
+//
+//     when an item is dequeued, at most k items enqueued before it are still queued
+//
+// k = 0 is strict FIFO (and serialises on the rescans); a larger k lets threads keep
+// working on their own shard. Items enqueued by one thread always come out in the
+// order that thread enqueued them, since a shard is only ever taken from the front.
+template <typename T>
+class shardedQueue
+{
+private:
+    static constexpr std::uint64_t kEmpty = std::numeric_limits<std::uint64_t>::max();
+
+    struct entry{
+        std::uint64_t ticket;
+        T value;
+    };
+
+    struct alignas(64) shard{
+        std::atomic<bool> locked{false};
+        std::atomic<std::uint64_t> headTicket{kEmpty};
+        ::queue<entry> items{64};
+
+        bool tryLock(){
+            return !locked.load(std::memory_order_relaxed) &&
+                   !locked.exchange(true, std::memory_order_acquire);
+        }
+
+        void lock(){
+            while(!tryLock()){
+                std::this_thread::yield();
+            }
+        }
+
+        // republish the cached front ticket before releasing the queue
+        void unlock(){
+            headTicket.store(items.empty() ? kEmpty : items.front().ticket, std::memory_order_relaxed);
+            locked.store(false, std::memory_order_release);
+        }
+    };
+
+    std::vector<std::unique_ptr<shard>> shards;
+    std::uint64_t k;
+    alignas(64) std::atomic<std::uint64_t> nextTicket{0};
+    alignas(64) std::atomic<std::uint64_t> floorTicket{0};    // <= oldest pending ticket, only grows
+    alignas(64) std::atomic<std::uint64_t> rescanCount{0};
+
+    static std::uint64_t nextRandom(){
+        static thread_local std::uint64_t s = 0x9e3779b97f4a7c15ULL ^
+            std::hash<std::thread::id>()(std::this_thread::get_id());
+        s ^= s << 13;
+        s ^= s >> 7;
+        s ^= s << 17;
+        return s;
+    }
+
+    shard& local(){
+        return *shards[threadIndex::get() % shards.size()];
+    }
+
+    // pops the front of s if it is within the bound; s must be locked by the caller
+    bool takeFront(shard& s, T& out, std::uint64_t* ticket){
+        // floorTicket never passes a pending ticket, so the difference cannot wrap
+        if(s.items.empty() || s.items.front().ticket - floorTicket.load(std::memory_order_acquire) > k){
+            return false;
+        }
+        if(ticket != nullptr){
+            *ticket = s.items.front().ticket;
+        }
+        out = std::move(s.items.front().value);
+        s.items.dequeue();
+        return true;
+    }
+
+    bool tryTake(shard& s, T& out, std::uint64_t* ticket){
+        if(s.headTicket.load(std::memory_order_relaxed) == kEmpty || !s.tryLock()){
+            return false;
+        }
+        bool got = takeFront(s, out, ticket);
+        s.unlock();
+        return got;
+    }
+
+    // Locks every shard in turn and raises floorTicket to the oldest ticket seen. A ticket
+    // older than `bound` is either in its shard when that shard is locked (its enqueue
+    // held the lock from taking the ticket to publishing the item) or already gone, so
+    // the result never exceeds the true oldest pending ticket. Returns the shard holding
+    // the oldest item, nullptr if every shard was empty.
+    shard* rescan(){
+        rescanCount.fetch_add(1, std::memory_order_relaxed);
+        std::uint64_t bound = nextTicket.load(std::memory_order_acquire);
+        shard* oldest = nullptr;
+        for(auto& s : shards){
+            s->lock();
+            if(!s->items.empty() && s->items.front().ticket < bound){
+                bound = s->items.front().ticket;
+                oldest = s.get();
+            }
+            s->unlock();
+        }
+        std::uint64_t f = floorTicket.load(std::memory_order_relaxed);
+        while(bound > f && !floorTicket.compare_exchange_weak(f, bound, std::memory_order_release,
+                                                               std::memory_order_relaxed)){
+        }
+        return oldest;
+    }
+
+public:
+    // ctor: k is the ordering relaxation, see above
+    explicit shardedQueue(std::size_t shardCount = std::thread::hardware_concurrency(), std::uint64_t k = 1024)
+        : k(k){
+        if(shardCount == 0){
+            shardCount = 1;     // hardware_concurrency() may report 0
+        }
+        for(std::size_t i = 0; i < shardCount; i++){
+            shards.emplace_back(new shard);
+        }
+    }
+
+    shardedQueue(const shardedQueue&) = delete;
+    shardedQueue& operator=(const shardedQueue&) = delete;
+
+    void enqueue(const T& value){
+        shard& s = local();
+        s.lock();
+        try
+        {
+            s.items.enqueue(entry{nextTicket.fetch_add(1, std::memory_order_relaxed), value});
+        }
+        catch(...)
+        {
+            // the ticket is burnt; that only makes floorTicket more conservative
+            s.unlock();
+            throw;
+        }
+        s.unlock();
+    }
+
+    // false if every shard was empty when looked at; ticket (optional) receives the
+    // item's position in the global enqueue order
+    bool tryDequeue(T& out, std::uint64_t* ticket = nullptr){
+        shard& mine = local();
+        for(;;){
+            if(tryTake(mine, out, ticket)){
+                return true;
+            }
+            if(shards.size() > 1 && tryTake(*shards[nextRandom() % shards.size()], out, ticket)){
+                return true;
+            }
+            shard* oldest = rescan();
+            if(oldest == nullptr){
+                return false;
+            }
+            // after a rescan the oldest item always qualifies, unless someone took it first
+            oldest->lock();
+            bool got = takeFront(*oldest, out, ticket);
+            oldest->unlock();
+            if(got){
+                return true;
+            }
+        }
+    }
+
+    T dequeue(){
+        T out;
+        if(!tryDequeue(out)){
+            throw std::underflow_error("Queue is empty");
+        }
+        return out;
+    }
+
+    // the k of the bound documented above
+    std::uint64_t relaxation() const{
+        return k;
+    }
+
+    std::size_t shardCount() const{
+        return shards.size();
+    }
+
+    // full passes over the shards so far; high when k is too small for the workload
+    std::uint64_t rescans() const{
+        return rescanCount.load(std::memory_order_relaxed);
+    }
+
+    // snapshot, may be stale by the time it returns
+    std::size_t size(){
+        std::size_t n = 0;
+        for(auto& s : shards){
+            s->lock();
+            n += s->items.size();
+            s->unlock();
+        }
+        return n;
+    }
+
+    bool empty(){
+        return size() == 0;
+    }
+};
@@ -0,0 +1,219 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <cstdint>
+
+// 包含你的shardedQueue實現，以及作為基準的mpmcRing
+#include "shardedQueue.cpp"
+#include "mpmcRing.cpp"
+
+// 測試計數器
+int tests_passed = 0;
+int tests_total = 0;
+
+// 測試輔助宏
+#define TEST(name) \
+    void test_##name(); \
+    void run_test_##name() { \
+        tests_total++; \
+        std::cout << "Testing " #name "... "; \
+        try { \
+            test_##name(); \
+            tests_passed++; \
+            std::cout << "PASSED\n"; \
+        } catch (const std::exception& e) { \
+            std::cout << "FAILED: " << e.what() << "\n"; \
+        } catch (...) { \
+            std::cout << "FAILED: Unknown exception\n"; \
+        } \
+    } \
+    void test_##name()
+
+// 輔助：threads個producer同時存活(各自拿到不同的shard)，每個enqueue per個值
+static void fillFromThreads(shardedQueue<std::uint64_t>& q, int threads, int per) {
+    std::atomic<int> started{0}, finished{0};
+    std::vector<std::thread> ts;
+    for (int t = 0; t < threads; t++) {
+        ts.emplace_back([&, t] {
+            started.fetch_add(1);
+            while (started.load() < threads) std::this_thread::yield();
+            for (int i = 0; i < per; i++) {
+                q.enqueue(std::uint64_t(t) * per + i);
+                if (i % 64 == 0) std::this_thread::yield();  // 讓各shard的ticket交錯
+            }
+            // 全部做完才離開，thread index才不會被回收給下一個producer
+            finished.fetch_add(1);
+            while (finished.load() < threads) std::this_thread::yield();
+        });
+    }
+    for (auto& th : ts) th.join();
+}
+
+// ============= 基本功能測試 =============
+
+TEST(single_thread_fifo) {
+    shardedQueue<std::string> q(4, 8);
+    assert(q.shardCount() == 4 && q.relaxation() == 8);
+    for (int i = 0; i < 1000; i++) q.enqueue(std::to_string(i));
+    assert(q.size() == 1000);
+    for (int i = 0; i < 1000; i++) assert(q.dequeue() == std::to_string(i));  // 一個thread只用一個shard
+    assert(q.empty());
+
+    std::string s;
+    assert(!q.tryDequeue(s));
+    try {
+        q.dequeue();
+        assert(false);
+    } catch (const std::underflow_error&) {
+        // 預期的異常
+    }
+}
+
+TEST(ordering_bound_holds) {
+    const int THREADS = 4, PER = 20000;
+    for (std::uint64_t k : {0, 1, 16, 256}) {
+        shardedQueue<std::uint64_t> q(THREADS, k);
+        fillFromThreads(q, THREADS, PER);
+
+        const std::size_t n = std::size_t(THREADS) * PER;
+        std::vector<bool> taken(n, false);
+        std::vector<std::uint64_t> lastOf(THREADS, 0);
+        std::vector<bool> seen(THREADS, false);
+        std::size_t oldest = 0;  // 最小的還沒出隊的ticket
+        std::uint64_t v, ticket;
+        std::size_t worst = 0;
+        while (q.tryDequeue(v, &ticket)) {
+            assert(ticket < n && !taken[ticket]);
+            // 比它早進隊、還在隊裡的 <= ticket - oldest <= k
+            assert(ticket - oldest <= k);
+            worst = std::max<std::size_t>(worst, ticket - oldest);
+            taken[ticket] = true;
+            while (oldest < n && taken[oldest]) oldest++;
+
+            // 同一個producer的值依序出來
+            std::size_t p = v / PER;
+            assert(!seen[p] || v > lastOf[p]);
+            seen[p] = true;
+            lastOf[p] = v;
+        }
+        assert(oldest == n);
+        if (k == 0) assert(worst == 0);  // k = 0：嚴格FIFO
+    }
+}
+
+TEST(concurrent_nothing_lost) {
+    const int THREADS = 4, PER = 50000;
+    shardedQueue<std::uint64_t> q(THREADS, 64);
+    std::atomic<std::uint64_t> sum{0};
+    std::atomic<int> count{0};
+    std::vector<std::thread> ts;
+    for (int t = 0; t < THREADS; t++) {
+        ts.emplace_back([&, t] {
+            std::uint64_t v;
+            for (int i = 0; i < PER; i++) {
+                q.enqueue(std::uint64_t(t) * PER + i);
+                if (i % 2 == 1 && q.tryDequeue(v)) {
+                    sum.fetch_add(v);
+                    count.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto& th : ts) th.join();
+
+    std::uint64_t v;
+    while (q.tryDequeue(v)) {
+        sum.fetch_add(v);
+        count.fetch_add(1);
+    }
+    const std::uint64_t n = std::uint64_t(THREADS) * PER;
+    assert(count.load() == int(n));
+    assert(sum.load() == n * (n - 1) / 2);
+}
+
+// ============= 性能測試 =============
+
+// 每個thread交替enqueue/dequeue，回傳每秒操作數(百萬)
+template <typename Enqueue, typename Dequeue>
+static double throughput(int threads, int opsPerThread, Enqueue enqueue, Dequeue dequeue) {
+    std::atomic<bool> go{false};
+    std::vector<std::thread> ts;
+    for (int t = 0; t < threads; t++) {
+        ts.emplace_back([&, t] {
+            while (!go.load()) std::this_thread::yield();
+            for (int i = 0; i < opsPerThread; i++) {
+                if (i % 2 == 0) enqueue(std::uint64_t(t) << 32 | i);
+                else dequeue();
+            }
+        });
+    }
+    auto t0 = std::chrono::steady_clock::now();
+    go.store(true);
+    for (auto& th : ts) th.join();
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return threads * double(opsPerThread) / s / 1e6;
+}
+
+TEST(scaling_vs_mpmc_ring) {
+    const int OPS = 4000000;
+    int cores = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "\n  (" << cores << " hardware threads)";
+
+    std::vector<int> counts;
+    for (int t = 1; t < cores; t *= 2) counts.push_back(t);
+    counts.push_back(cores);
+    if (cores < 4) counts.push_back(4);  // 核心太少時也看一下超額訂閱的情況
+
+    for (int threads : counts) {
+        mpmcRing<std::uint64_t> ring(1 << 16);
+        double ringRate = throughput(threads, OPS / threads,
+            [&](std::uint64_t v) { ring.tryEnqueue(v); },
+            [&] { std::uint64_t v; ring.tryDequeue(v); });
+
+        shardedQueue<std::uint64_t> relaxed(threads, 1024);
+        double relaxedRate = throughput(threads, OPS / threads,
+            [&](std::uint64_t v) { relaxed.enqueue(v); },
+            [&] { std::uint64_t v; relaxed.tryDequeue(v); });
+
+        shardedQueue<std::uint64_t> strict(threads, 0);
+        double strictRate = throughput(threads, OPS / threads,
+            [&](std::uint64_t v) { strict.enqueue(v); },
+            [&] { std::uint64_t v; strict.tryDequeue(v); });
+
+        std::cout << "\n  " << threads << " threads: mpmcRing " << ringRate << " Mops/s, sharded k=1024 "
+                  << relaxedRate << " Mops/s (" << relaxed.rescans() << " rescans), sharded k=0 " << strictRate
+                  << " Mops/s (" << strict.rescans() << " rescans)";
+    }
+    std::cout << " ";
+}
+
+// ============= 主測試函數 =============
+
+int main() {
+    std::cout << "=== ShardedQueue 測試套件 ===\n\n";
+
+    // 運行所有測試
+    run_test_single_thread_fifo();
+    run_test_ordering_bound_holds();
+    run_test_concurrent_nothing_lost();
+    run_test_scaling_vs_mpmc_ring();
+
+    // 測試結果
+    std::cout << "\n=== 測試結果 ===\n";
+    std::cout << "通過: " << tests_passed << "/" << tests_total << " 測試\n";
+
+    if (tests_passed == tests_total) {
+        std::cout << "🎉 所有測試通過！\n";
+        return 0;
+    } else {
+        std::cout << "❌ 有 " << (tests_total - tests_passed) << " 個測試失敗\n";
+        return 1;
+    }
+}
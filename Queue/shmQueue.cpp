@@ -0,0 +1,348 @@
+#include <iostream>
+#include <utility>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <atomic>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <new>
+#include <cstdint>
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// circularQueue whose header and slots live in a named POSIX shared-memory segment
+// (shm_open + mmap), so co-located processes can exchange fixed-size records without
+// a syscall on the fast path.
+//
+// Indices are the per-slot sequence scheme of a bounded MPMC ring restricted to one
+// consumer: the producer side is either a plain store (single producer) or a CAS on
+// the tail (multi producer), chosen when the segment is created.
+//
+// The creating process owns the name and unlinks it on destruction; other processes
+// attach by name and are checked against the creator's version and layout.
+template <typename T>
+class shmQueue
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "shmQueue copies records between processes and needs a trivially copyable T");
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+                  "shmQueue needs address-free 64-bit atomics");
+
+private:
+    static constexpr std::uint64_t kMagic = 0x51554555484d5351ULL;   // "QSMHUEUQ"
+    static constexpr std::uint32_t kVersion = 1;
+    static constexpr std::uint32_t kReady = 1;
+
+    struct slot{
+        std::atomic<std::uint64_t> seq;
+        T value;
+    };
+
+    struct header{
+        std::uint64_t magic;
+        std::uint32_t version;
+        std::uint32_t multiProducer;
+        std::uint64_t cap;
+        std::uint64_t slotSize;
+        std::uint64_t valueSize;
+        std::uint64_t valueAlign;
+        std::atomic<std::uint32_t> state;
+        std::atomic<std::uint32_t> attached;
+        alignas(64) std::atomic<std::uint64_t> tail;
+        alignas(64) std::atomic<std::uint64_t> head;
+    };
+
+    std::string name;
+    header* hdr;
+    slot* slots;
+    std::size_t mask;
+    std::size_t mapBytes;
+    bool owner;
+
+    static std::size_t segmentBytes(std::size_t cap){
+        return sizeof(header) + cap * sizeof(slot);
+    }
+
+    static std::size_t roundPow2(std::size_t n){
+        std::size_t p = 1;
+        while(p < n){
+            p <<= 1;
+        }
+        return p;
+    }
+
+    static void* mapSegment(int fd, std::size_t bytes){
+        void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if(p == MAP_FAILED){
+            throw std::system_error(errno, std::generic_category(), "mmap");
+        }
+        return p;
+    }
+
+    void create(std::size_t cap, bool multiProducer){
+        int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if(fd < 0){
+            throw std::system_error(errno, std::generic_category(), "shm_open(create) " + name);
+        }
+        mapBytes = segmentBytes(cap);
+        void* p = nullptr;
+        try
+        {
+            if(ftruncate(fd, static_cast<off_t>(mapBytes)) != 0){
+                throw std::system_error(errno, std::generic_category(), "ftruncate");
+            }
+            p = mapSegment(fd, mapBytes);
+        }
+        catch(...)
+        {
+            close(fd);
+            shm_unlink(name.c_str());
+            throw;
+        }
+        close(fd);
+
+        hdr = new (p) header;
+        hdr->magic = kMagic;
+        hdr->version = kVersion;
+        hdr->multiProducer = multiProducer ? 1 : 0;
+        hdr->cap = cap;
+        hdr->slotSize = sizeof(slot);
+        hdr->valueSize = sizeof(T);
+        hdr->valueAlign = alignof(T);
+        hdr->attached.store(1, std::memory_order_relaxed);
+        hdr->tail.store(0, std::memory_order_relaxed);
+        hdr->head.store(0, std::memory_order_relaxed);
+        slots = reinterpret_cast<slot*>(hdr + 1);
+        for(std::size_t i = 0; i < cap; i++){
+            new (&slots[i].seq) std::atomic<std::uint64_t>(i);
+        }
+        mask = cap - 1;
+        // publish the initialised segment to attaching processes
+        hdr->state.store(kReady, std::memory_order_release);
+    }
+
+    void attach(std::chrono::milliseconds timeout){
+        int fd = shm_open(name.c_str(), O_RDWR, 0600);
+        if(fd < 0){
+            throw std::system_error(errno, std::generic_category(), "shm_open(attach) " + name);
+        }
+
+        // the creator may still be between shm_open and ftruncate/initialisation
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        struct stat st;
+        for(;;){
+            if(fstat(fd, &st) != 0){
+                int err = errno;
+                close(fd);
+                throw std::system_error(err, std::generic_category(), "fstat");
+            }
+            if(static_cast<std::size_t>(st.st_size) >= sizeof(header)){
+                break;
+            }
+            if(std::chrono::steady_clock::now() > deadline){
+                close(fd);
+                throw std::runtime_error("shmQueue: segment " + name + " was never initialised");
+            }
+            std::this_thread::yield();
+        }
+
+        mapBytes = static_cast<std::size_t>(st.st_size);
+        void* p = nullptr;
+        try
+        {
+            p = mapSegment(fd, mapBytes);
+        }
+        catch(...)
+        {
+            close(fd);
+            throw;
+        }
+        close(fd);
+        hdr = static_cast<header*>(p);
+        auto fail = [&](const std::string& why){
+            munmap(hdr, mapBytes);
+            hdr = nullptr;
+            throw std::runtime_error("shmQueue: " + name + " " + why);
+        };
+
+        while(hdr->state.load(std::memory_order_acquire) != kReady){
+            if(std::chrono::steady_clock::now() > deadline){
+                fail("was never initialised");
+            }
+            std::this_thread::yield();
+        }
+
+        if(hdr->magic != kMagic || hdr->version != kVersion){
+            fail("has an incompatible version");
+        }
+        if(hdr->slotSize != sizeof(slot) || hdr->valueSize != sizeof(T) ||
+           hdr->valueAlign != alignof(T)){
+            fail("has a different record layout");
+        }
+        // mask and every slot index come from cap, so it must be a power of two that
+        // exactly fills the mapping (checked by division first so it cannot overflow)
+        std::uint64_t cap = hdr->cap;
+        if(cap == 0 || (cap & (cap - 1)) != 0 || cap > (mapBytes - sizeof(header)) / sizeof(slot) ||
+           segmentBytes(cap) != mapBytes){
+            fail("has a corrupt capacity");
+        }
+
+        slots = reinterpret_cast<slot*>(hdr + 1);
+        mask = hdr->cap - 1;
+        hdr->attached.fetch_add(1, std::memory_order_relaxed);
+    }
+
+public:
+    // ctor: create the segment, cap is rounded up to a power of two
+    shmQueue(const std::string& name, std::size_t cap, bool multiProducer = false)
+        : name(name), hdr(nullptr), slots(nullptr), mask(0), mapBytes(0), owner(true){
+        create(roundPow2(cap == 0 ? 1 : cap), multiProducer);
+    }
+
+    // ctor: attach to a segment created by another process
+    explicit shmQueue(const std::string& name, std::chrono::milliseconds timeout = std::chrono::seconds(1))
+        : name(name), hdr(nullptr), slots(nullptr), mask(0), mapBytes(0), owner(false){
+        attach(timeout);
+    }
+
+    shmQueue(const shmQueue&) = delete;
+    shmQueue& operator=(const shmQueue&) = delete;
+
+    // move ctor
+    shmQueue(shmQueue&& other) noexcept :
+        name(std::move(other.name)),
+        hdr(std::exchange(other.hdr, nullptr)),
+        slots(std::exchange(other.slots, nullptr)),
+        mask(std::exchange(other.mask, 0)),
+        mapBytes(std::exchange(other.mapBytes, 0)),
+        owner(std::exchange(other.owner, false)){}
+
+    // move assignment
+    shmQueue& operator=(shmQueue&& other) noexcept{
+        shmQueue tmp(std::move(other));
+        swap(tmp);
+        return *this;
+    }
+
+    // destructor
+    ~shmQueue(){
+        detach();
+    }
+
+    void swap(shmQueue& other) noexcept{
+        std::swap(name, other.name);
+        std::swap(hdr, other.hdr);
+        std::swap(slots, other.slots);
+        std::swap(mask, other.mask);
+        std::swap(mapBytes, other.mapBytes);
+        std::swap(owner, other.owner);
+    }
+
+    // unmap this process's view; the owner also removes the name. Safe to call twice.
+    void detach() noexcept{
+        if(hdr == nullptr){
+            return;
+        }
+        hdr->attached.fetch_sub(1, std::memory_order_relaxed);
+        munmap(hdr, mapBytes);
+        hdr = nullptr;
+        slots = nullptr;
+        if(owner){
+            shm_unlink(name.c_str());
+            owner = false;
+        }
+    }
+
+    // remove a stale segment left behind by a crashed owner
+    static void unlink(const std::string& name) noexcept{
+        shm_unlink(name.c_str());
+    }
+
+    bool tryEnqueue(const T& value){
+        std::uint64_t pos = hdr->tail.load(std::memory_order_relaxed);
+        slot* s;
+        for(;;){
+            s = &slots[pos & mask];
+            std::uint64_t seq = s->seq.load(std::memory_order_acquire);
+            std::int64_t diff = static_cast<std::int64_t>(seq - pos);
+            if(diff == 0){
+                if(!hdr->multiProducer){
+                    hdr->tail.store(pos + 1, std::memory_order_relaxed);
+                    break;
+                }
+                if(hdr->tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)){
+                    break;
+                }
+            }
+            else if(diff < 0){
+                return false;
+            }
+            else{
+                pos = hdr->tail.load(std::memory_order_relaxed);
+            }
+        }
+        s->value = value;
+        s->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // single consumer
+    bool tryDequeue(T& out){
+        std::uint64_t pos = hdr->head.load(std::memory_order_relaxed);
+        slot& s = slots[pos & mask];
+        if(s.seq.load(std::memory_order_acquire) != pos + 1){
+            return false;
+        }
+        out = s.value;
+        hdr->head.store(pos + 1, std::memory_order_relaxed);
+        s.seq.store(pos + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    void enqueue(const T& value){
+        if(!tryEnqueue(value)){
+            throw std::overflow_error("Queue is full");
+        }
+    }
+
+    T dequeue(){
+        T out;
+        if(!tryDequeue(out)){
+            throw std::underflow_error("Queue is empty");
+        }
+        return out;
+    }
+
+    // snapshot, may be stale by the time it returns
+    std::size_t size() const{
+        std::uint64_t head = hdr->head.load(std::memory_order_acquire);
+        std::uint64_t tail = hdr->tail.load(std::memory_order_acquire);
+        return tail > head ? static_cast<std::size_t>(tail - head) : 0;
+    }
+
+    bool empty() const{
+        return size() == 0;
+    }
+
+    std::size_t capacity() const{
+        return mask + 1;
+    }
+
+    // number of processes currently mapping the segment
+    std::size_t attachedCount() const{
+        return hdr->attached.load(std::memory_order_relaxed);
+    }
+
+    bool isOwner() const{
+        return owner;
+    }
+
+    const std::string& segmentName() const{
+        return name;
+    }
+};
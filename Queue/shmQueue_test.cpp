@@ -0,0 +1,270 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <chrono>
+#include <thread>
+#include <cstdint>
+#include <sys/wait.h>
+
+// 包含你的shared-memory queue實現
+#include "shmQueue.cpp"
+
+// 測試計數器
+int tests_passed = 0;
+int tests_total = 0;
+
+// 測試輔助宏
+#define TEST(name) \
+    void test_##name(); \
+    void run_test_##name() { \
+        tests_total++; \
+        std::cout << "Testing " #name "... "; \
+        try { \
+            test_##name(); \
+            tests_passed++; \
+            std::cout << "PASSED\n"; \
+        } catch (const std::exception& e) { \
+            std::cout << "FAILED: " << e.what() << "\n"; \
+        } catch (...) { \
+            std::cout << "FAILED: Unknown exception\n"; \
+        } \
+    } \
+    void test_##name()
+
+// 每個測試用不同的segment名稱，避免與其他行程衝突
+static std::string segment(const char* tag) {
+    return "/shmQueue_test_" + std::to_string(getpid()) + "_" + tag;
+}
+
+struct message {
+    std::uint64_t id;
+    std::uint64_t payload[3];
+};
+
+// ============= 基本功能測試 =============
+
+TEST(create_and_attach) {
+    std::string name = segment("basic");
+    shmQueue<message> producer(name, 5);
+    assert(producer.isOwner());
+    assert(producer.capacity() == 8);  // 向上取2的冪次
+    assert(producer.empty());
+
+    shmQueue<message> consumer(name);
+    assert(!consumer.isOwner());
+    assert(consumer.capacity() == 8);
+    assert(producer.attachedCount() == 2);
+
+    producer.enqueue(message{1, {10, 20, 30}});
+    producer.enqueue(message{2, {40, 50, 60}});
+    assert(consumer.size() == 2);
+
+    message m = consumer.dequeue();
+    assert(m.id == 1 && m.payload[2] == 30);
+    m = consumer.dequeue();
+    assert(m.id == 2 && m.payload[0] == 40);
+    assert(consumer.empty());
+
+    consumer.detach();
+    consumer.detach();  // 重複detach應該安全
+    assert(producer.attachedCount() == 1);
+}
+
+TEST(full_and_empty) {
+    std::string name = segment("full");
+    shmQueue<int> q(name, 4);
+    for (int i = 0; i < 4; i++) assert(q.tryEnqueue(i));
+    assert(!q.tryEnqueue(99));
+    try {
+        q.enqueue(99);
+        assert(false);
+    } catch (const std::overflow_error&) {
+        // 預期的異常
+    }
+
+    int v;
+    for (int i = 0; i < 4; i++) {
+        assert(q.tryDequeue(v));
+        assert(v == i);
+    }
+    assert(!q.tryDequeue(v));
+    try {
+        q.dequeue();
+        assert(false);
+    } catch (const std::underflow_error&) {
+        // 預期的異常
+    }
+
+    // 多輪環繞
+    for (int round = 0; round < 10; round++) {
+        for (int i = 0; i < 3; i++) q.enqueue(round * 10 + i);
+        for (int i = 0; i < 3; i++) assert(q.dequeue() == round * 10 + i);
+    }
+}
+
+TEST(layout_and_lifetime_checks) {
+    std::string name = segment("layout");
+    {
+        shmQueue<std::uint32_t> q(name, 8);
+
+        // 不同的record型別不能attach
+        try {
+            shmQueue<message> wrong(name);
+            assert(false);
+        } catch (const std::runtime_error&) {
+            // 預期的異常
+        }
+
+        // 同名不能重複建立
+        try {
+            shmQueue<std::uint32_t> dup(name, 8);
+            assert(false);
+        } catch (const std::system_error&) {
+            // 預期的異常
+        }
+    }
+
+    // header裡的容量被破壞時拒絕attach：0、不是2的冪次、和segment大小不符
+    {
+        shmQueue<std::uint32_t> q(name, 8);
+        int fd = shm_open(name.c_str(), O_RDWR, 0600);
+        assert(fd >= 0);
+        void* p = mmap(nullptr, 64, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        assert(p != MAP_FAILED);
+        // cap在magic、version、multiProducer之後
+        std::uint64_t* cap = reinterpret_cast<std::uint64_t*>(static_cast<char*>(p) + 16);
+        assert(*cap == 8);
+        for (std::uint64_t bad : {0, 6, 16, 4}) {
+            *cap = bad;
+            try {
+                shmQueue<std::uint32_t> corrupt(name);
+                assert(false);
+            } catch (const std::runtime_error&) {
+                // 預期的異常
+            }
+        }
+        *cap = 8;
+        shmQueue<std::uint32_t> ok(name);
+        assert(ok.capacity() == 8);
+        munmap(p, 64);
+    }
+
+    // owner析構後名稱被移除
+    try {
+        shmQueue<std::uint32_t> gone(name, std::chrono::milliseconds(10));
+        assert(false);
+    } catch (const std::system_error&) {
+        // 預期的異常
+    }
+}
+
+TEST(multi_producer) {
+    std::string name = segment("mpsc");
+    shmQueue<std::uint64_t> q(name, 1024, true);
+    const int PRODUCERS = 4;
+    const std::uint64_t PER = 20000;
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < PRODUCERS; p++) {
+        threads.emplace_back([&, p] {
+            shmQueue<std::uint64_t> view(name);
+            for (std::uint64_t i = 0; i < PER; i++) {
+                while (!view.tryEnqueue((static_cast<std::uint64_t>(p) << 32) | i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::vector<std::uint64_t> next(PRODUCERS, 0);
+    std::uint64_t received = 0, v;
+    while (received < PRODUCERS * PER) {
+        if (!q.tryDequeue(v)) {
+            std::this_thread::yield();
+            continue;
+        }
+        int p = static_cast<int>(v >> 32);
+        assert((v & 0xffffffffULL) == next[p]);  // 每個producer內部保持FIFO
+        next[p]++;
+        received++;
+    }
+    for (auto& t : threads) t.join();
+    assert(q.empty());
+}
+
+// ============= 跨行程延遲測試 =============
+
+TEST(two_process_latency) {
+    std::string pingName = segment("ping");
+    std::string pongName = segment("pong");
+    const int ROUNDS = 100000;
+
+    shmQueue<message> ping(pingName, 64);
+    shmQueue<message> pong(pongName, 64);
+
+    pid_t child = fork();
+    if (child == 0) {
+        // 子行程：收到ping就回pong
+        int rc = 0;
+        try {
+            shmQueue<message> in(pingName);
+            shmQueue<message> out(pongName);
+            message m;
+            for (int i = 0; i < ROUNDS; i++) {
+                while (!in.tryDequeue(m)) std::this_thread::yield();
+                m.payload[0] = m.id * 2;
+                while (!out.tryEnqueue(m)) std::this_thread::yield();
+            }
+        } catch (...) {
+            rc = 1;
+        }
+        _exit(rc);
+    }
+    assert(child > 0);
+
+    message m{0, {0, 0, 0}};
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ROUNDS; i++) {
+        m.id = static_cast<std::uint64_t>(i);
+        while (!ping.tryEnqueue(m)) std::this_thread::yield();
+        while (!pong.tryDequeue(m)) std::this_thread::yield();
+        assert(m.id == static_cast<std::uint64_t>(i) && m.payload[0] == m.id * 2);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    int status = 0;
+    waitpid(child, &status, 0);
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    std::cout << "\n  round trip: " << ns / ROUNDS << " ns avg over " << ROUNDS << " messages ";
+}
+
+// ============= 主測試函數 =============
+
+int main() {
+    std::cout << "=== ShmQueue 測試套件 ===\n\n";
+
+    // 運行所有測試
+    run_test_create_and_attach();
+    run_test_full_and_empty();
+    run_test_layout_and_lifetime_checks();
+    run_test_multi_producer();
+    run_test_two_process_latency();
+
+    // 測試結果
+    std::cout << "\n=== 測試結果 ===\n";
+    std::cout << "通過: " << tests_passed << "/" << tests_total << " 測試\n";
+
+    if (tests_passed == tests_total) {
+        std::cout << "🎉 所有測試通過！\n";
+        return 0;
+    } else {
+        std::cout << "❌ 有 " << (tests_total - tests_passed) << " 個測試失敗\n";
+        return 1;
+    }
+}
@@ -0,0 +1,210 @@
+#include <iostream>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+#include <cstdint>
+
+#include "circularQueue.cpp"
+
+enum class windowKind { count, time };
+
+// Rolling min / max / sum / mean over the most recent samples of a stream.
+//
+//   windowKind::count  the last `length` samples        add(value)
+//   windowKind::time   samples with time > now - length add(time, value), expire(now)
+//
+// Samples live in a circularQueue; min and max are monotonic deques on two more rings
+// (candidates are popped from the back while dominated, from the front when they leave
+// the window), so every add is amortized O(1). The sum is kept incrementally and, for
+// floating-point T, recomputed from the samples once as many evictions as the window
+// holds have happened, which bounds the cancellation drift at amortized O(1) cost.
+// T must be totally ordered (no NaN).
+template <typename T = double>
+class slidingWindow
+{
+public:
+    typedef typename std::conditional<std::is_floating_point<T>::value, double, long long>::type sumType;
+
+private:
+    struct sample{
+        std::int64_t time;
+        T value;
+    };
+
+    struct candidate{
+        std::uint64_t seq;
+        T value;
+    };
+
+    windowKind kind;
+    std::int64_t length;
+    circularQueue<sample> samples;
+    circularQueue<candidate> mins;
+    circularQueue<candidate> maxs;
+    std::uint64_t nextSeq = 0;          // sequence number of the next sample; samples hold
+                                        // [nextSeq - size, nextSeq)
+    std::int64_t lastTime = 0;          // timestamp of the last add(), valid once hasTime
+    bool hasTime = false;
+    sumType total = 0;
+    std::size_t evictedSinceRecompute = 0;
+    std::size_t recomputeCount = 0;
+
+    static ringMode storageMode(windowKind kind){
+        return kind == windowKind::count ? ringMode::bounded : ringMode::grow;
+    }
+
+    static int initialCap(windowKind kind, std::int64_t length){
+        if(length <= 0){
+            throw std::invalid_argument("window length must be positive");
+        }
+        if(kind == windowKind::count){
+            if(length > 0x7fffffff){
+                throw std::invalid_argument("count window too large");
+            }
+            return static_cast<int>(length);
+        }
+        return 64;
+    }
+
+    void push(std::int64_t time, const T& value){
+        std::uint64_t seq = nextSeq++;
+        while(!mins.empty() && !(mins.back().value < value)){
+            mins.dequeueBack();
+        }
+        mins.enqueue(candidate{seq, value});
+        while(!maxs.empty() && !(value < maxs.back().value)){
+            maxs.dequeueBack();
+        }
+        maxs.enqueue(candidate{seq, value});
+        samples.enqueue(sample{time, value});
+        total += static_cast<sumType>(value);
+    }
+
+    void popOldest(){
+        std::uint64_t seq = nextSeq - samples.size();
+        total -= static_cast<sumType>(samples.front().value);
+        samples.dequeue();
+        if(mins.front().seq == seq){
+            mins.dequeue();
+        }
+        if(maxs.front().seq == seq){
+            maxs.dequeue();
+        }
+
+        if(samples.empty()){
+            total = 0;
+            evictedSinceRecompute = 0;
+        }
+        else if(std::is_floating_point<T>::value && ++evictedSinceRecompute >= samples.size()){
+            recompute();
+        }
+    }
+
+    void recompute(){
+        sumType s = 0;
+        auto spans = samples.readable_spans();
+        for(std::size_t i = 0; i < spans.first.len; i++){
+            s += static_cast<sumType>(spans.first.ptr[i].value);
+        }
+        for(std::size_t i = 0; i < spans.second.len; i++){
+            s += static_cast<sumType>(spans.second.ptr[i].value);
+        }
+        total = s;
+        evictedSinceRecompute = 0;
+        recomputeCount++;
+    }
+
+public:
+    // ctor: length is a sample count or a time span (in the caller's time unit)
+    explicit slidingWindow(std::int64_t length, windowKind kind = windowKind::count)
+        : kind(kind), length(length),
+          samples(initialCap(kind, length), storageMode(kind)),
+          mins(initialCap(kind, length), storageMode(kind)),
+          maxs(initialCap(kind, length), storageMode(kind)){}
+
+    // count window only
+    void add(const T& value){
+        if(kind != windowKind::count){
+            throw std::logic_error("time window needs a timestamp");
+        }
+        if(samples.isFull()){
+            popOldest();
+        }
+        push(static_cast<std::int64_t>(nextSeq), value);
+    }
+
+    // time window: timestamps must not go backwards, even after every sample has
+    // expired; samples older than time - length are evicted. On a count window the
+    // timestamp is ignored.
+    void add(std::int64_t time, const T& value){
+        if(kind == windowKind::count){
+            add(value);
+            return;
+        }
+        if(hasTime && time < lastTime){
+            throw std::invalid_argument("timestamps must be non-decreasing");
+        }
+        lastTime = time;
+        hasTime = true;
+        push(time, value);
+        expire(time);
+    }
+
+    // drop time-window samples that fell out of (now - length, now]
+    void expire(std::int64_t now){
+        if(kind != windowKind::time){
+            return;
+        }
+        while(!samples.empty() && samples.front().time <= now - length){
+            popOldest();
+        }
+    }
+
+    const T& min() const{
+        if(samples.empty()){
+            throw std::runtime_error("Window is empty");
+        }
+        return mins.front().value;
+    }
+
+    const T& max() const{
+        if(samples.empty()){
+            throw std::runtime_error("Window is empty");
+        }
+        return maxs.front().value;
+    }
+
+    sumType sum() const{
+        return total;
+    }
+
+    double mean() const{
+        if(samples.empty()){
+            throw std::runtime_error("Window is empty");
+        }
+        return static_cast<double>(total) / static_cast<double>(samples.size());
+    }
+
+    std::size_t size() const{
+        return samples.size();
+    }
+
+    bool empty() const{
+        return samples.empty();
+    }
+
+    // starts over, so the next timestamp may be anything again
+    void clear(){
+        hasTime = false;
+        samples.clear();
+        mins.clear();
+        maxs.clear();
+        total = 0;
+        evictedSinceRecompute = 0;
+    }
+
+    // how many times the running sum was rebuilt from the samples
+    std::size_t recomputations() const{
+        return recomputeCount;
+    }
+};
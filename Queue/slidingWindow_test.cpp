@@ -0,0 +1,272 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+// 包含你的sliding window實現
+#include "slidingWindow.cpp"
+
+// 測試計數器
+int tests_passed = 0;
+int tests_total = 0;
+
+// 測試輔助宏
+#define TEST(name) \
+    void test_##name(); \
+    void run_test_##name() { \
+        tests_total++; \
+        std::cout << "Testing " #name "... "; \
+        try { \
+            test_##name(); \
+            tests_passed++; \
+            std::cout << "PASSED\n"; \
+        } catch (const std::exception& e) { \
+            std::cout << "FAILED: " << e.what() << "\n"; \
+        } catch (...) { \
+            std::cout << "FAILED: Unknown exception\n"; \
+        } \
+    } \
+    void test_##name()
+
+// ============= 基本功能測試 =============
+
+TEST(count_window_basic) {
+    slidingWindow<int> w(3);
+    assert(w.empty());
+
+    w.add(5);
+    assert(w.min() == 5 && w.max() == 5 && w.sum() == 5);
+    w.add(1);
+    w.add(9);
+    assert(w.min() == 1 && w.max() == 9 && w.sum() == 15);
+    assert(w.mean() == 5.0);
+
+    w.add(4);  // 5離開視窗
+    assert(w.size() == 3);
+    assert(w.min() == 1 && w.max() == 9 && w.sum() == 14);
+    w.add(7);  // 1離開
+    assert(w.min() == 4 && w.max() == 9);
+    w.add(2);  // 9離開
+    assert(w.min() == 2 && w.max() == 7 && w.sum() == 13);
+}
+
+TEST(empty_window_throws) {
+    slidingWindow<double> w(4);
+    try {
+        w.min();
+        assert(false);
+    } catch (const std::runtime_error&) {
+        // 預期的異常
+    }
+    try {
+        w.mean();
+        assert(false);
+    } catch (const std::runtime_error&) {
+        // 預期的異常
+    }
+    try {
+        slidingWindow<double> bad(0);
+        assert(false);
+    } catch (const std::invalid_argument&) {
+        // 預期的異常
+    }
+
+    // time window必須提供時間戳，且時間不能倒退
+    slidingWindow<double> t(10, windowKind::time);
+    try {
+        t.add(1.0);
+        assert(false);
+    } catch (const std::logic_error&) {
+        // 預期的異常
+    }
+    t.add(100, 1.0);
+    try {
+        t.add(99, 1.0);
+        assert(false);
+    } catch (const std::invalid_argument&) {
+        // 預期的異常
+    }
+}
+
+TEST(time_window) {
+    slidingWindow<double> w(100, windowKind::time);  // 保留 (now - 100, now]
+    w.add(0, 3.0);
+    w.add(50, 8.0);
+    w.add(90, 1.0);
+    assert(w.size() == 3 && w.min() == 1.0 && w.max() == 8.0);
+
+    w.add(100, 2.0);  // t=0 離開
+    assert(w.size() == 3 && w.sum() == 11.0);
+    w.add(150, 5.0);  // t=50 離開
+    assert(w.size() == 3 && w.max() == 5.0 && w.min() == 1.0);
+
+    w.expire(201);  // 沒有新樣本也可以過期
+    assert(w.size() == 1 && w.min() == 5.0 && w.max() == 5.0);
+    w.expire(250);
+    assert(w.empty() && w.sum() == 0.0);
+
+    // 突發流量讓儲存空間成長
+    for (int i = 0; i < 1000; i++) w.add(300, double(i));
+    assert(w.size() == 1000 && w.min() == 0.0 && w.max() == 999.0);
+    w.add(400, -1.0);
+    assert(w.size() == 1 && w.max() == -1.0);
+
+    // 全部過期之後，時間仍然不能倒退
+    w.expire(1000);
+    assert(w.empty());
+    try {
+        w.add(399, 1.0);
+        assert(false);
+    } catch (const std::invalid_argument&) {
+        // 預期的異常
+    }
+    w.clear();  // clear()之後重新開始
+    w.add(0, 1.0);
+    assert(w.size() == 1);
+}
+
+TEST(random_against_rescan) {
+    std::mt19937 rng(1);
+    const int N = 37;
+    slidingWindow<long long> w(N);
+    std::vector<long long> all;
+    for (int i = 0; i < 20000; i++) {
+        long long v = static_cast<long long>(rng() % 1000) - 500;
+        w.add(v);
+        all.push_back(v);
+        std::size_t from = all.size() > N ? all.size() - N : 0;
+        long long mn = all[from], mx = all[from], s = 0;
+        for (std::size_t j = from; j < all.size(); j++) {
+            mn = std::min(mn, all[j]);
+            mx = std::max(mx, all[j]);
+            s += all[j];
+        }
+        assert(w.min() == mn && w.max() == mx && w.sum() == s);
+    }
+}
+
+TEST(recompute_bounds_drift) {
+    // 大數進出視窗後，增量和會遺失小數；重算把它修正回來
+    slidingWindow<double> w(100);
+    for (int i = 0; i < 100; i++) w.add(1e16);
+    for (int i = 0; i < 100; i++) w.add(1.0);
+    assert(w.recomputations() >= 1);
+    for (int i = 0; i < 100; i++) w.add(1.0);  // 大數全部離開後的下一次重算得到精確值
+    assert(w.recomputations() >= 2);
+    assert(w.sum() == 100.0);
+    assert(w.mean() == 1.0);
+
+    // 長時間運行後誤差仍然有界
+    std::mt19937_64 rng(3);
+    std::uniform_real_distribution<double> dist(-1e6, 1e6);
+    slidingWindow<double> big(1000);
+    std::vector<double> recent;
+    for (int i = 0; i < 200000; i++) {
+        double v = dist(rng);
+        big.add(v);
+        recent.push_back(v);
+    }
+    double exact = 0;
+    for (std::size_t i = recent.size() - 1000; i < recent.size(); i++) exact += recent[i];
+    assert(std::fabs(big.sum() - exact) < 1e-3);
+}
+
+// ============= 性能測試 =============
+
+TEST(ten_million_samples_vs_rescan) {
+    const int N = 10000000;
+    const int WINDOW = 1000;
+    std::mt19937 rng(9);
+    std::vector<double> data(N);
+    for (auto& d : data) d = rng() % 100000 * 0.01;
+
+    // 固定數量視窗
+    double checksum = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    {
+        slidingWindow<double> w(WINDOW);
+        for (int i = 0; i < N; i++) {
+            w.add(data[i]);
+            checksum += w.min() + w.max() + w.mean();
+        }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+
+    // 時間視窗：每個樣本相隔100ns (10M samples/s)，保留最近100us
+    double checksumTime = 0;
+    {
+        slidingWindow<double> w(100000, windowKind::time);
+        for (int i = 0; i < N; i++) {
+            w.add(std::int64_t(i) * 100, data[i]);
+            checksumTime += w.max();
+        }
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    // 每次重新掃描整個視窗（樣本數較少，否則要跑太久）
+    const int NAIVE = 200000;
+    double checksumNaive = 0, checksumFast = 0;
+    auto t3 = std::chrono::steady_clock::now();
+    for (int i = 0; i < NAIVE; i++) {
+        int from = std::max(0, i - WINDOW + 1);
+        double mn = data[from], mx = data[from], s = 0;
+        for (int j = from; j <= i; j++) {
+            mn = std::min(mn, data[j]);
+            mx = std::max(mx, data[j]);
+            s += data[j];
+        }
+        checksumNaive += mn + mx + s / (i - from + 1);
+    }
+    auto t4 = std::chrono::steady_clock::now();
+    {
+        slidingWindow<double> w(WINDOW);
+        for (int i = 0; i < NAIVE; i++) {
+            w.add(data[i]);
+            checksumFast += w.min() + w.max() + w.mean();
+        }
+    }
+    assert(std::fabs(checksumNaive - checksumFast) < 1e-6 * std::fabs(checksumNaive));
+    assert(checksum > 0 && checksumTime > 0);
+
+    auto ns = [](std::chrono::steady_clock::time_point a, std::chrono::steady_clock::time_point b, int n) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(b - a).count() / double(n);
+    };
+    double perSample = ns(t0, t1, N);
+    std::cout << "\n  count window(" << WINDOW << "): " << perSample << "ns/sample ("
+              << 1000.0 / perSample << "M samples/s)"
+              << "\n  time window(1000 samples): " << ns(t1, t2, N) << "ns/sample"
+              << "\n  naive rescan: " << ns(t3, t4, NAIVE) << "ns/sample ";
+}
+
+// ============= 主測試函數 =============
+
+int main() {
+    std::cout << "=== SlidingWindow 測試套件 ===\n\n";
+
+    // 運行所有測試
+    run_test_count_window_basic();
+    run_test_empty_window_throws();
+    run_test_time_window();
+    run_test_random_against_rescan();
+    run_test_recompute_bounds_drift();
+    run_test_ten_million_samples_vs_rescan();
+
+    // 測試結果
+    std::cout << "\n=== 測試結果 ===\n";
+    std::cout << "通過: " << tests_passed << "/" << tests_total << " 測試\n";
+
+    if (tests_passed == tests_total) {
+        std::cout << "🎉 所有測試通過！\n";
+        return 0;
+    } else {
+        std::cout << "❌ 有 " << (tests_total - tests_passed) << " 個測試失敗\n";
+        return 1;
+    }
+}
@@ -0,0 +1,220 @@
+#include <iostream>
+#include <utility>
+#include <stdexcept>
+#include <array>
+#include <initializer_list>
+#include <cstddef>
+
+#include "circularQueue.cpp"
+
+// circularQueue with the capacity fixed at compile time: the ring lives in a std::array
+// inside the object, so there is no allocation, and when N is a power of two wrapping an
+// index is a single AND with a constant mask. Every member is constexpr, so a queue can
+// be filled and drained inside a constant expression (lookup tables, test vectors).
+// Method names follow circularQueue; ringMode::grow is not available since N is fixed.
+// T must be default-constructible, and a literal type for compile-time use.
+template <typename T, std::size_t N>
+class static_circular_queue
+{
+    static_assert(N > 0, "static_circular_queue needs a positive capacity");
+
+private:
+    std::array<T, N> data{};
+    std::size_t frontIdx = 0;
+    std::size_t rearIdx = 0;
+    std::size_t count = 0;
+    ringMode mode = ringMode::bounded;
+    std::size_t droppedCount = 0;
+
+    static constexpr bool kPow2 = (N & (N - 1)) == 0;
+
+    // i < 2N
+    static constexpr std::size_t wrap(std::size_t i){
+        if constexpr (kPow2){
+            return i & (N - 1);
+        }
+        else{
+            return i >= N ? i - N : i;
+        }
+    }
+
+    constexpr std::size_t reserveSlot(){
+        if(count == N && mode != ringMode::overwrite){
+            throw std::overflow_error("Queue is full");
+        }
+        return rearIdx;
+    }
+
+    constexpr void commitSlot(){
+        rearIdx = wrap(rearIdx + 1);
+        if(count == N){
+            frontIdx = rearIdx;
+            droppedCount++;
+        }
+        else{
+            count++;
+        }
+    }
+
+public:
+    // ctor
+    constexpr static_circular_queue() = default;
+
+    // ctor with overflow mode
+    constexpr explicit static_circular_queue(ringMode mode) : mode(mode){
+        if(mode == ringMode::grow){
+            throw std::invalid_argument("static_circular_queue cannot grow");
+        }
+    }
+
+    // ctor
+    constexpr static_circular_queue(std::initializer_list<T> init){
+        for(const T& v : init){
+            enqueue(v);
+        }
+    }
+
+    // std::swap is not constexpr before C++20
+    constexpr void swap(static_circular_queue& other) noexcept{
+        static_circular_queue tmp = std::move(other);
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    constexpr void enqueue(const T& value){
+        std::size_t idx = reserveSlot();
+        data[idx] = value;
+        commitSlot();
+    }
+
+    constexpr void enqueue(T&& value){
+        std::size_t idx = reserveSlot();
+        data[idx] = std::move(value);
+        commitSlot();
+    }
+
+    constexpr void dequeue(){
+        if(count == 0){
+            throw std::underflow_error("Queue is empty");
+        }
+        frontIdx = wrap(frontIdx + 1);
+        count--;
+    }
+
+    constexpr void dequeueBack(){
+        if(count == 0){
+            throw std::underflow_error("Queue is empty");
+        }
+        rearIdx = wrap(rearIdx + N - 1);
+        count--;
+    }
+
+    constexpr const T& front() const{
+        if(count == 0){
+            throw std::runtime_error("Queue is empty");
+        }
+        return data[frontIdx];
+    }
+
+    constexpr T& front(){
+        if(count == 0){
+            throw std::runtime_error("Queue is empty");
+        }
+        return data[frontIdx];
+    }
+
+    constexpr const T& back() const{
+        if(count == 0){
+            throw std::runtime_error("Queue is empty");
+        }
+        return data[wrap(rearIdx + N - 1)];
+    }
+
+    // i-th element from the front, unchecked
+    constexpr T& operator[](std::size_t i){
+        return data[wrap(frontIdx + i)];
+    }
+
+    constexpr const T& operator[](std::size_t i) const{
+        return data[wrap(frontIdx + i)];
+    }
+
+    constexpr bool empty() const{
+        return count == 0;
+    }
+
+    constexpr bool isFull() const{
+        return count == N;
+    }
+
+    static constexpr std::size_t capacity(){
+        return N;
+    }
+
+    constexpr std::size_t size() const{
+        return count;
+    }
+
+    constexpr ringMode overflowMode() const{
+        return mode;
+    }
+
+    constexpr void setOverflowMode(ringMode newMode){
+        if(newMode == ringMode::grow){
+            throw std::invalid_argument("static_circular_queue cannot grow");
+        }
+        mode = newMode;
+    }
+
+    // number of elements evicted by enqueue in overwrite mode
+    constexpr std::size_t dropped() const{
+        return droppedCount;
+    }
+
+    // copy the current contents oldest-first into out, returns the end of the output range
+    template <typename OutputIt>
+    constexpr OutputIt snapshot(OutputIt out) const{
+        for(std::size_t i = 0; i < count; i++){
+            *out++ = data[wrap(frontIdx + i)];
+        }
+        return out;
+    }
+
+    // copy up to n elements from src, returns how many were taken
+    // bounded mode stops at the free space; overwrite mode takes all n and evicts the oldest
+    constexpr std::size_t enqueue_bulk(const T* src, std::size_t n){
+        if(mode == ringMode::bounded && n > N - count){
+            n = N - count;
+        }
+        for(std::size_t i = 0; i < n; i++){
+            enqueue(src[i]);
+        }
+        return n;
+    }
+
+    // move up to n elements into dst oldest-first, returns how many were moved
+    constexpr std::size_t dequeue_bulk(T* dst, std::size_t n){
+        n = n < count ? n : count;
+        for(std::size_t i = 0; i < n; i++){
+            dst[i] = std::move(data[wrap(frontIdx + i)]);
+        }
+        frontIdx = wrap(frontIdx + n % N);
+        count -= n;
+        return n;
+    }
+
+    // also resets dropped(), as circularQueue::clear() does
+    constexpr void clear(){
+        frontIdx = rearIdx = 0;
+        count = 0;
+        droppedCount = 0;
+    }
+
+    void print() const{
+        std::cout << "Queue(front -> back) : ";
+        for(std::size_t i = 0; i < count; i++){
+            std::cout << data[wrap(frontIdx + i)] << " ";
+        }
+        std::cout << std::endl;
+    }
+};
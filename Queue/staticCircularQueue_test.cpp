@@ -0,0 +1,214 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <iterator>
+#include <array>
+#include <chrono>
+
+// 包含你的固定容量circular queue實現
+#include "staticCircularQueue.cpp"
+
+// 測試計數器
+int tests_passed = 0;
+int tests_total = 0;
+
+// 測試輔助宏
+#define TEST(name) \
+    void test_##name(); \
+    void run_test_##name() { \
+        tests_total++; \
+        std::cout << "Testing " #name "... "; \
+        try { \
+            test_##name(); \
+            tests_passed++; \
+            std::cout << "PASSED\n"; \
+        } catch (const std::exception& e) { \
+            std::cout << "FAILED: " << e.what() << "\n"; \
+        } catch (...) { \
+            std::cout << "FAILED: Unknown exception\n"; \
+        } \
+    } \
+    void test_##name()
+
+// ============= 編譯期測試 =============
+
+// 在常數表達式裡繞圈：N不是2的冪，走比較分支
+constexpr int wrapAroundSum() {
+    static_circular_queue<int, 3> q;
+    int sum = 0;
+    for (int i = 1; i <= 10; i++) {
+        q.enqueue(i);
+        if (q.isFull()) {
+            sum += q.front();
+            q.dequeue();
+        }
+    }
+    while (!q.empty()) {
+        sum += q.front();
+        q.dequeue();
+    }
+    return sum;
+}
+static_assert(wrapAroundSum() == 55, "wrap-around at compile time");
+
+// overwrite模式只留下最新的N個
+constexpr static_circular_queue<int, 4> lastFour() {
+    static_circular_queue<int, 4> q(ringMode::overwrite);
+    for (int i = 0; i < 10; i++) q.enqueue(i);
+    return q;
+}
+static_assert(lastFour().front() == 6 && lastFour().back() == 9, "overwrite keeps the newest");
+static_assert(lastFour().dropped() == 6, "overwrite counts evictions");
+static_assert(lastFour()[2] == 8, "indexing from the front");
+
+// 用佇列在編譯期產生查找表：前16個Hamming數(2^a 3^b 5^c)
+constexpr std::array<int, 16> hammingTable() {
+    std::array<int, 16> out{};
+    static_circular_queue<int, 16> q2, q3, q5;
+    int next = 1;
+    for (std::size_t i = 0; i < out.size(); i++) {
+        out[i] = next;
+        q2.enqueue(next * 2);
+        q3.enqueue(next * 3);
+        q5.enqueue(next * 5);
+        int a = q2.front(), b = q3.front(), c = q5.front();
+        next = a < b ? (a < c ? a : c) : (b < c ? b : c);
+        if (q2.front() == next) q2.dequeue();
+        if (q3.front() == next) q3.dequeue();
+        if (q5.front() == next) q5.dequeue();
+    }
+    return out;
+}
+constexpr std::array<int, 16> kHamming = hammingTable();
+static_assert(kHamming[0] == 1 && kHamming[5] == 6 && kHamming[15] == 25, "hamming table");
+
+constexpr bool dequeBackAndSwap() {
+    static_circular_queue<int, 8> a{1, 2, 3};
+    static_circular_queue<int, 8> b{9};
+    a.dequeueBack();
+    a.swap(b);
+    return a.size() == 1 && a.front() == 9 && b.size() == 2 && b.back() == 2;
+}
+static_assert(dequeBackAndSwap(), "dequeueBack and swap are constexpr");
+static_assert(static_circular_queue<char, 5>::capacity() == 5, "capacity is a constant");
+
+// ============= 基本功能測試 =============
+
+TEST(runtime_behaviour_matches_circular_queue) {
+    static_circular_queue<std::string, 4> s;
+    circularQueue<std::string> c(4);
+    for (const char* v : {"a", "b", "c", "d"}) {
+        s.enqueue(v);
+        c.enqueue(v);
+    }
+    assert(s.isFull() && c.isFull());
+    for (int i = 0; i < 4; i++) assert(s[i] == c[i]);
+
+    try {
+        s.enqueue("e");
+        assert(false);
+    } catch (const std::overflow_error&) {
+        // 預期的異常
+    }
+
+    s.dequeue();
+    s.enqueue("e");
+    std::vector<std::string> snap;
+    s.snapshot(std::back_inserter(snap));
+    assert((snap == std::vector<std::string>{"b", "c", "d", "e"}));
+
+    std::string out[8];
+    assert(s.dequeue_bulk(out, 8) == 4);
+    assert(out[0] == "b" && out[3] == "e");
+    assert(s.empty());
+    try {
+        s.dequeue();
+        assert(false);
+    } catch (const std::underflow_error&) {
+        // 預期的異常
+    }
+    try {
+        s.front();
+        assert(false);
+    } catch (const std::runtime_error&) {
+        // 預期的異常
+    }
+    try {
+        s.setOverflowMode(ringMode::grow);
+        assert(false);
+    } catch (const std::invalid_argument&) {
+        // 預期的異常
+    }
+}
+
+TEST(bulk_and_overwrite) {
+    static_circular_queue<int, 5> q;
+    int src[7] = {1, 2, 3, 4, 5, 6, 7};
+    assert(q.enqueue_bulk(src, 7) == 5);  // bounded：只收得下5個
+    assert(q.back() == 5);
+
+    q.setOverflowMode(ringMode::overwrite);
+    assert(q.enqueue_bulk(src, 7) == 7);
+    assert(q.front() == 3 && q.back() == 7 && q.dropped() == 7);
+    assert(sizeof(q) < sizeof(int) * 5 + 64);  // 沒有heap配置，資料就在物件裡
+}
+
+// ============= 性能測試 =============
+
+// 滿佇列上的穩定狀態：每次enqueue前先dequeue最舊的，回傳每次操作的ns
+template <typename Q>
+static double churn(Q& q, int ops, long long& sum) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < ops; i++) {
+        if (q.isFull()) {
+            sum += q.front();
+            q.dequeue();
+        }
+        q.enqueue(i);
+    }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / ops;
+}
+
+TEST(fixed_vs_heap_ring) {
+    const int OPS = 50000000;
+    long long sumPow2 = 0, sumOdd = 0, sumHeap = 0;
+
+    static_circular_queue<int, 1024> pow2;
+    static_circular_queue<int, 1000> odd;
+    circularQueue<int> heap(1024);
+    churn(heap, OPS / 10, sumHeap);  // 預熱
+    sumHeap = 0;
+    double nsHeap = churn(heap, OPS, sumHeap);
+    double nsPow2 = churn(pow2, OPS, sumPow2);
+    double nsOdd = churn(odd, OPS, sumOdd);
+    assert(sumPow2 > 0 && sumOdd > 0 && sumHeap > 0);
+
+    std::cout << "\n  steady-state churn: static_circular_queue<int, 1024> " << nsPow2
+              << " ns/op, <int, 1000> " << nsOdd << " ns/op, circularQueue<int>(1024) " << nsHeap << " ns/op ";
+}
+
+// ============= 主測試函數 =============
+
+int main() {
+    std::cout << "=== StaticCircularQueue 測試套件 ===\n\n";
+
+    // 運行所有測試
+    run_test_runtime_behaviour_matches_circular_queue();
+    run_test_bulk_and_overwrite();
+    run_test_fixed_vs_heap_ring();
+
+    // 測試結果
+    std::cout << "\n=== 測試結果 ===\n";
+    std::cout << "通過: " << tests_passed << "/" << tests_total << " 測試\n";
+
+    if (tests_passed == tests_total) {
+        std::cout << "🎉 所有測試通過！\n";
+        return 0;
+    } else {
+        std::cout << "❌ 有 " << (tests_total - tests_passed) << " 個測試失敗\n";
+        return 1;
+    }
+}
@@ -0,0 +1,200 @@
+#include <iostream>
+#include <utility>
+#include <stdexcept>
+#include <functional>
+#include <vector>
+#include <cstdint>
+
+// Hierarchical timing wheel. Each level is a ring of slot lists indexed like
+// circularQueue (tick & mask); level L covers 2^(bitsPerLevel*(L+1)) ticks. A timer
+// is placed on the lowest level whose span contains its deadline; when a lower level
+// wraps, the next level's current slot is cascaded down. schedule() and cancel() are
+// O(1); advance() is O(ticks elapsed + timers fired/cascaded).
+//
+// Timers live in a pooled node array with intrusive doubly-linked slot lists, and a
+// handle carries a generation so cancelling an already fired/cancelled timer is a no-op.
+class timerWheel
+{
+public:
+    struct handle{
+        std::uint32_t index;
+        std::uint32_t generation;
+    };
+
+private:
+    static constexpr unsigned kBits = 8;
+    static constexpr std::size_t kSlots = std::size_t(1) << kBits;
+    static constexpr std::size_t kMask = kSlots - 1;
+    static constexpr unsigned kLevels = 8;          // 8 * 8 bits = full 64-bit tick range
+    static constexpr std::uint32_t kNone = 0xffffffffu;
+
+    struct node{
+        std::uint64_t deadline;
+        std::function<void()> cb;
+        std::uint32_t prev;
+        std::uint32_t next;
+        std::uint32_t generation;
+        std::uint32_t slot;         // level * kSlots + slot index, kNone when free
+    };
+
+    std::vector<node> nodes;
+    std::uint32_t freeList;
+    std::vector<std::uint32_t> heads;   // kLevels * kSlots list heads
+    std::size_t levelCount[kLevels];
+    std::uint64_t now;
+    std::size_t active;
+
+    std::uint32_t allocNode(){
+        if(freeList != kNone){
+            std::uint32_t i = freeList;
+            freeList = nodes[i].next;
+            return i;
+        }
+        if(nodes.size() >= kNone){
+            throw std::length_error("timerWheel: too many timers");
+        }
+        nodes.push_back(node{0, nullptr, kNone, kNone, 0, kNone});
+        return static_cast<std::uint32_t>(nodes.size() - 1);
+    }
+
+    void freeNode(std::uint32_t i){
+        nodes[i].cb = nullptr;
+        nodes[i].slot = kNone;
+        nodes[i].generation++;
+        nodes[i].next = freeList;
+        freeList = i;
+    }
+
+    void link(std::uint32_t i){
+        std::uint64_t deadline = nodes[i].deadline < now ? now : nodes[i].deadline;
+        std::uint64_t delta = deadline - now;
+        unsigned level = 0;
+        while(level + 1 < kLevels && delta >= (std::uint64_t(1) << (kBits * (level + 1)))){
+            level++;
+        }
+        std::size_t slotIdx = static_cast<std::size_t>(deadline >> (kBits * level)) & kMask;
+        std::uint32_t s = static_cast<std::uint32_t>(level * kSlots + slotIdx);
+        levelCount[level]++;
+
+        node& n = nodes[i];
+        n.slot = s;
+        n.prev = kNone;
+        n.next = heads[s];
+        if(heads[s] != kNone){
+            nodes[heads[s]].prev = i;
+        }
+        heads[s] = i;
+    }
+
+    void unlink(std::uint32_t i){
+        node& n = nodes[i];
+        levelCount[n.slot / kSlots]--;
+        if(n.prev != kNone){
+            nodes[n.prev].next = n.next;
+        }
+        else{
+            heads[n.slot] = n.next;
+        }
+        if(n.next != kNone){
+            nodes[n.next].prev = n.prev;
+        }
+    }
+
+    // move every timer in (level, slot) down to the level that now fits it
+    void cascade(unsigned level, std::size_t slotIdx){
+        std::uint32_t s = static_cast<std::uint32_t>(level * kSlots + slotIdx);
+        std::uint32_t i = heads[s];
+        heads[s] = kNone;
+        while(i != kNone){
+            std::uint32_t next = nodes[i].next;
+            levelCount[level]--;
+            link(i);
+            i = next;
+        }
+    }
+
+    // pop one timer at a time so a callback may schedule or cancel other timers
+    void fireSlot(std::size_t slotIdx){
+        while(heads[slotIdx] != kNone){
+            std::uint32_t i = heads[slotIdx];
+            unlink(i);
+            std::function<void()> cb = std::move(nodes[i].cb);
+            freeNode(i);
+            active--;
+            cb();
+        }
+    }
+
+public:
+    // ctor, start is the current tick
+    explicit timerWheel(std::uint64_t start = 0)
+        : freeList(kNone), heads(kLevels * kSlots, kNone), levelCount(), now(start), active(0){}
+
+    // run cb once advance() reaches deadline (a deadline in the past fires on the next tick)
+    handle schedule(std::uint64_t deadline, std::function<void()> cb){
+        std::uint32_t i = allocNode();
+        nodes[i].deadline = deadline > now ? deadline : now + 1;
+        nodes[i].cb = std::move(cb);
+        link(i);
+        active++;
+        return handle{i, nodes[i].generation};
+    }
+
+    // false if the timer already fired or was cancelled
+    bool cancel(handle h){
+        if(h.index >= nodes.size() || nodes[h.index].generation != h.generation ||
+           nodes[h.index].slot == kNone){
+            return false;
+        }
+        unlink(h.index);
+        freeNode(h.index);
+        active--;
+        return true;
+    }
+
+    // move the clock to newNow, firing every timer with deadline <= newNow in deadline order
+    // (timers sharing a tick fire in no particular order)
+    void advance(std::uint64_t newNow){
+        while(now < newNow){
+            if(active == 0){
+                now = newNow;
+                return;
+            }
+            // nothing moves until the next cascade boundary of the lowest non-empty level
+            unsigned lowest = 0;
+            while(levelCount[lowest] == 0){
+                lowest++;
+            }
+            if(lowest > 0){
+                std::uint64_t span = std::uint64_t(1) << (kBits * lowest);
+                std::uint64_t boundary = (now | (span - 1));   // last tick before the boundary
+                if(boundary >= newNow){
+                    now = newNow;
+                    return;
+                }
+                now = boundary;
+            }
+            now++;
+            // entering a new slot on level L means level L+1 may hold timers that now fit lower
+            for(unsigned level = 1; level < kLevels; level++){
+                if((now & ((std::uint64_t(1) << (kBits * level)) - 1)) != 0){
+                    break;
+                }
+                cascade(level, static_cast<std::size_t>(now >> (kBits * level)) & kMask);
+            }
+            fireSlot(static_cast<std::size_t>(now) & kMask);
+        }
+    }
+
+    std::uint64_t currentTick() const{
+        return now;
+    }
+
+    std::size_t size() const{
+        return active;
+    }
+
+    bool empty() const{
+        return active == 0;
+    }
+};
@@ -0,0 +1,219 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <chrono>
+#include <queue>
+#include <random>
+#include <algorithm>
+#include <cstdint>
+
+// 包含你的timer wheel實現
+#include "timerWheel.cpp"
+
+// 測試計數器
+int tests_passed = 0;
+int tests_total = 0;
+
+// 測試輔助宏
+#define TEST(name) \
+    void test_##name(); \
+    void run_test_##name() { \
+        tests_total++; \
+        std::cout << "Testing " #name "... "; \
+        try { \
+            test_##name(); \
+            tests_passed++; \
+            std::cout << "PASSED\n"; \
+        } catch (const std::exception& e) { \
+            std::cout << "FAILED: " << e.what() << "\n"; \
+        } catch (...) { \
+            std::cout << "FAILED: Unknown exception\n"; \
+        } \
+    } \
+    void test_##name()
+
+// ============= 基本功能測試 =============
+
+TEST(fires_at_deadline) {
+    timerWheel w;
+    std::vector<std::uint64_t> fired;
+    w.schedule(5, [&] { fired.push_back(w.currentTick()); });
+    w.schedule(3, [&] { fired.push_back(w.currentTick()); });
+    w.schedule(300, [&] { fired.push_back(w.currentTick()); });  // 第二層
+    assert(w.size() == 3);
+
+    w.advance(2);
+    assert(fired.empty());
+    w.advance(5);
+    assert((fired == std::vector<std::uint64_t>{3, 5}));
+    w.advance(299);
+    assert(fired.size() == 2);
+    w.advance(1000);
+    assert((fired == std::vector<std::uint64_t>{3, 5, 300}));
+    assert(w.empty());
+}
+
+TEST(cancel_and_stale_handles) {
+    timerWheel w(100);
+    int count = 0;
+    auto a = w.schedule(150, [&] { count += 1; });
+    auto b = w.schedule(70000, [&] { count += 10; });
+    auto c = w.schedule(90, [&] { count += 100; });  // 過去的deadline在下一個tick觸發
+
+    assert(w.cancel(b));
+    assert(!w.cancel(b));  // 重複cancel
+    w.advance(200);
+    assert(count == 101);
+    assert(!w.cancel(a));  // 已經觸發
+    assert(!w.cancel(c));
+
+    // slot被重用後，舊handle不能取消新timer
+    auto d = w.schedule(300, [&] { count += 1000; });
+    assert(d.index == a.index || d.index == b.index || d.index == c.index);
+    assert(!w.cancel(a) && !w.cancel(b) && !w.cancel(c));
+    w.advance(300);
+    assert(count == 1101);
+}
+
+TEST(long_range_cascades) {
+    timerWheel w;
+    std::vector<std::uint64_t> fired;
+    const std::uint64_t deadlines[] = {
+        1ULL << 8, (1ULL << 16) + 7, (1ULL << 24) - 1, 123456789ULL, (1ULL << 40) + 3};
+    for (std::uint64_t d : deadlines) {
+        w.schedule(d, [&] { fired.push_back(w.currentTick()); });
+    }
+    w.advance(1ULL << 41);
+    assert(fired.size() == 5);
+    for (std::size_t i = 0; i < 5; i++) assert(fired[i] == deadlines[i]);
+}
+
+TEST(callbacks_can_reschedule_and_cancel) {
+    timerWheel w;
+    int ticks = 0;
+    std::function<void()> periodic = [&] {
+        ticks++;
+        if (ticks < 10) w.schedule(w.currentTick() + 10, periodic);
+    };
+    w.schedule(10, periodic);
+
+    int victimRan = 0;
+    timerWheel::handle victim = w.schedule(50, [&] { victimRan++; });
+    w.schedule(50, [&] { w.cancel(victim); });  // 同一個tick互相取消
+
+    w.advance(1000);
+    assert(ticks == 10);
+    assert(victimRan <= 1);
+    assert(w.empty());
+}
+
+TEST(random_against_reference) {
+    std::mt19937_64 rng(42);
+    timerWheel w;
+    std::vector<std::pair<std::uint64_t, int>> expected;
+    std::vector<std::pair<std::uint64_t, int>> fired;
+    std::vector<timerWheel::handle> handles;
+
+    for (int i = 0; i < 20000; i++) {
+        std::uint64_t d = rng() % 2000000;
+        handles.push_back(w.schedule(d, [&, i, d] { fired.push_back({w.currentTick(), i}); }));
+        expected.push_back({std::max<std::uint64_t>(d, 1), i});
+    }
+    for (int i = 0; i < 20000; i += 3) {
+        assert(w.cancel(handles[i]));
+        expected[i].second = -1;
+    }
+    expected.erase(std::remove_if(expected.begin(), expected.end(),
+                                  [](const std::pair<std::uint64_t, int>& e) { return e.second < 0; }),
+                   expected.end());
+
+    // 分段前進
+    for (std::uint64_t t = 0; t <= 2000000; t += 12345) w.advance(t);
+    w.advance(2000000);
+
+    std::sort(expected.begin(), expected.end());
+    std::sort(fired.begin(), fired.end());
+    assert(fired == expected);
+}
+
+// ============= 性能測試 =============
+
+TEST(one_million_timers_vs_heap) {
+    const int N = 1000000;
+    const std::uint64_t HORIZON = 10000000;
+    std::mt19937_64 rng(7);
+    std::vector<std::uint64_t> deadlines(N);
+    for (auto& d : deadlines) d = 1 + rng() % HORIZON;
+
+    // timer wheel
+    long long firedWheel = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    {
+        timerWheel w;
+        std::vector<timerWheel::handle> hs;
+        hs.reserve(N);
+        for (int i = 0; i < N; i++) hs.push_back(w.schedule(deadlines[i], [&] { firedWheel++; }));
+        for (int i = 0; i < N; i += 2) w.cancel(hs[i]);
+        for (std::uint64_t t = 0; t <= HORIZON; t += 1000) w.advance(t);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+
+    // binary heap + lazy cancel
+    long long firedHeap = 0;
+    {
+        typedef std::pair<std::uint64_t, int> entry;
+        std::priority_queue<entry, std::vector<entry>, std::greater<entry>> heap;
+        std::vector<std::function<void()>> cbs(N);
+        std::vector<char> cancelled(N, 0);
+        for (int i = 0; i < N; i++) {
+            cbs[i] = [&] { firedHeap++; };
+            heap.push({deadlines[i], i});
+        }
+        for (int i = 0; i < N; i += 2) cancelled[i] = 1;
+        for (std::uint64_t t = 0; t <= HORIZON; t += 1000) {
+            while (!heap.empty() && heap.top().first <= t) {
+                int id = heap.top().second;
+                heap.pop();
+                if (!cancelled[id]) cbs[id]();
+            }
+        }
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    assert(firedWheel == N / 2);
+    assert(firedHeap == firedWheel);
+    auto ms = [](std::chrono::steady_clock::time_point a, std::chrono::steady_clock::time_point b) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(b - a).count();
+    };
+    std::cout << "\n  timer wheel: " << ms(t0, t1) << "ms, binary heap: " << ms(t1, t2) << "ms ("
+              << N << " timers, half cancelled) ";
+}
+
+// ============= 主測試函數 =============
+
+int main() {
+    std::cout << "=== TimerWheel 測試套件 ===\n\n";
+
+    // 運行所有測試
+    run_test_fires_at_deadline();
+    run_test_cancel_and_stale_handles();
+    run_test_long_range_cascades();
+    run_test_callbacks_can_reschedule_and_cancel();
+    run_test_random_against_reference();
+    run_test_one_million_timers_vs_heap();
+
+    // 測試結果
+    std::cout << "\n=== 測試結果 ===\n";
+    std::cout << "通過: " << tests_passed << "/" << tests_total << " 測試\n";
+
+    if (tests_passed == tests_total) {
+        std::cout << "🎉 所有測試通過！\n";
+        return 0;
+    } else {
+        std::cout << "❌ 有 " << (tests_total - tests_passed) << " 個測試失敗\n";
+        return 1;
+    }
+}
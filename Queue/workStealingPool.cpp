@@ -0,0 +1,245 @@
+#include <iostream>
+#include <utility>
+#include <stdexcept>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <chrono>
+#include <cstdint>
+
+#include "chaseLevDeque.cpp"
+#include "circularQueue.cpp"
+
+// fork-join counter: spawn() increments it, a finished task decrements it, sync() waits
+// (while running other tasks) until it is back to zero and rethrows the first exception
+class taskGroup
+{
+    friend class workStealingPool;
+
+private:
+    std::atomic<std::size_t> pending{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+
+public:
+    std::size_t outstanding() const{
+        return pending.load(std::memory_order_acquire);
+    }
+};
+
+// thread pool on per-worker Chase-Lev deques. A worker spawns onto the bottom of its own
+// deque and pops from there (depth-first, cache-warm); idle workers steal from the top
+// of a random victim. Tasks spawned from outside the pool go through a shared injection
+// queue. sync() never blocks a worker: it keeps executing tasks until its group is done.
+class workStealingPool
+{
+private:
+    struct task{
+        std::function<void()> fn;
+        taskGroup* group;
+    };
+
+    struct worker{
+        chaseLevDeque<task*> deque;
+        std::uint64_t rng;
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<worker>> workers;
+    std::mutex injectMtx;
+    circularQueue<task*> injected{64, ringMode::grow};
+    std::atomic<std::size_t> injectedCount{0};
+
+    std::mutex sleepMtx;
+    std::condition_variable sleepCv;
+    std::atomic<int> sleepers{0};
+    std::atomic<bool> stopping{false};
+
+    static inline thread_local workStealingPool* currentPool = nullptr;
+    static inline thread_local std::size_t currentIndex = 0;
+
+    static std::uint64_t nextRandom(std::uint64_t& s){
+        s ^= s << 13;
+        s ^= s >> 7;
+        s ^= s << 17;
+        return s;
+    }
+
+    void run(task* t){
+        taskGroup* g = t->group;
+        try
+        {
+            t->fn();
+        }
+        catch(...)
+        {
+            if(!g->failed.exchange(true, std::memory_order_acq_rel)){
+                g->error = std::current_exception();
+            }
+        }
+        delete t;
+        g->pending.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    // a task that will never run: its group still has to reach zero, and sync() reports it
+    void discard(task* t){
+        taskGroup* g = t->group;
+        if(!g->failed.exchange(true, std::memory_order_acq_rel)){
+            g->error = std::make_exception_ptr(std::runtime_error("workStealingPool destroyed before the task ran"));
+        }
+        delete t;
+        g->pending.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    bool takeInjected(task*& out){
+        if(injectedCount.load(std::memory_order_acquire) == 0){
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(injectMtx);
+        if(injected.empty()){
+            return false;
+        }
+        out = injected.front();
+        injected.dequeue();
+        injectedCount.fetch_sub(1, std::memory_order_release);
+        return true;
+    }
+
+    bool stealFrom(std::size_t self, std::uint64_t& rng, task*& out){
+        std::size_t n = workers.size();
+        std::size_t start = static_cast<std::size_t>(nextRandom(rng) % n);
+        for(std::size_t i = 0; i < n; i++){
+            std::size_t victim = (start + i) % n;
+            if(victim != self && workers[victim]->deque.steal(out)){
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // one unit of work for the calling thread; false if nothing was found
+    bool runOne(){
+        task* t = nullptr;
+        if(currentPool == this){
+            worker& w = *workers[currentIndex];
+            if(w.deque.pop(t) || stealFrom(currentIndex, w.rng, t) || takeInjected(t)){
+                run(t);
+                return true;
+            }
+            return false;
+        }
+        static thread_local std::uint64_t rng = 0x9e3779b97f4a7c15ULL ^
+            std::hash<std::thread::id>()(std::this_thread::get_id());
+        if(takeInjected(t) || stealFrom(workers.size(), rng, t)){
+            run(t);
+            return true;
+        }
+        return false;
+    }
+
+    void workerLoop(std::size_t index){
+        currentPool = this;
+        currentIndex = index;
+        int idle = 0;
+        while(!stopping.load(std::memory_order_acquire)){
+            if(runOne()){
+                idle = 0;
+                continue;
+            }
+            if(++idle < 64){
+                std::this_thread::yield();
+                continue;
+            }
+            // park; spawn() only pays for a notify when somebody is parked
+            std::unique_lock<std::mutex> lock(sleepMtx);
+            sleepers.fetch_add(1);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            sleepCv.wait_for(lock, std::chrono::milliseconds(1));
+            sleepers.fetch_sub(1);
+            idle = 0;
+        }
+        currentPool = nullptr;
+    }
+
+    void wake(){
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(sleepers.load() > 0){
+            sleepCv.notify_one();
+        }
+    }
+
+public:
+    // ctor
+    explicit workStealingPool(std::size_t threads = std::thread::hardware_concurrency()){
+        if(threads == 0){
+            threads = 1;
+        }
+        for(std::size_t i = 0; i < threads; i++){
+            workers.emplace_back(new worker);
+            workers.back()->rng = 0x9e3779b97f4a7c15ULL * (i + 1);
+        }
+        for(std::size_t i = 0; i < threads; i++){
+            workers[i]->thread = std::thread(&workStealingPool::workerLoop, this, i);
+        }
+    }
+
+    workStealingPool(const workStealingPool&) = delete;
+    workStealingPool& operator=(const workStealingPool&) = delete;
+
+    // destructor: tasks that have not started by now are dropped and counted as failed in
+    // their group, so every group still reaches zero
+    ~workStealingPool(){
+        stopping.store(true, std::memory_order_release);
+        sleepCv.notify_all();
+        for(auto& w : workers){
+            w->thread.join();
+        }
+        // the workers are gone, so this thread may act as the owner of every deque
+        task* t = nullptr;
+        for(auto& w : workers){
+            while(w->deque.pop(t)){
+                discard(t);
+            }
+        }
+        while(takeInjected(t)){
+            discard(t);
+        }
+    }
+
+    void spawn(taskGroup& group, std::function<void()> fn){
+        task* t = new task{std::move(fn), &group};
+        group.pending.fetch_add(1, std::memory_order_relaxed);
+        if(currentPool == this){
+            workers[currentIndex]->deque.push(t);
+        }
+        else{
+            std::lock_guard<std::mutex> lock(injectMtx);
+            injected.enqueue(t);
+            injectedCount.fetch_add(1, std::memory_order_release);
+        }
+        wake();
+    }
+
+    // wait for every task spawned into group, executing pool work in the meantime
+    void sync(taskGroup& group){
+        while(group.pending.load(std::memory_order_acquire) != 0){
+            if(!runOne()){
+                std::this_thread::yield();
+            }
+        }
+        if(group.failed.load(std::memory_order_acquire)){
+            std::exception_ptr e = std::exchange(group.error, nullptr);
+            group.failed.store(false, std::memory_order_relaxed);
+            std::rethrow_exception(e);
+        }
+    }
+
+    std::size_t threadCount() const{
+        return workers.size();
+    }
+};
@@ -0,0 +1,255 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <numeric>
+#include <memory>
+#include <cstdint>
+
+// 包含work-stealing deque與thread pool實現
+#include "workStealingPool.cpp"
+
+// 測試計數器
+int tests_passed = 0;
+int tests_total = 0;
+
+// 測試輔助宏
+#define TEST(name) \
+    void test_##name(); \
+    void run_test_##name() { \
+        tests_total++; \
+        std::cout << "Testing " #name "... "; \
+        try { \
+            test_##name(); \
+            tests_passed++; \
+            std::cout << "PASSED\n"; \
+        } catch (const std::exception& e) { \
+            std::cout << "FAILED: " << e.what() << "\n"; \
+        } catch (...) { \
+            std::cout << "FAILED: Unknown exception\n"; \
+        } \
+    } \
+    void test_##name()
+
+// ============= Chase-Lev deque 測試 =============
+
+TEST(deque_owner_lifo_thief_fifo) {
+    chaseLevDeque<int> d(2);
+    for (int i = 0; i < 5; i++) d.push(i);  // 觸發兩次擴容
+    assert(d.size() == 5);
+    assert(d.capacity() == 8);
+
+    int v;
+    assert(d.pop(v) && v == 4);    // owner從bottom拿
+    assert(d.steal(v) && v == 0);  // thief從top拿
+    assert(d.steal(v) && v == 1);
+    assert(d.pop(v) && v == 3);
+    assert(d.pop(v) && v == 2);
+    assert(!d.pop(v));
+    assert(!d.steal(v));
+    assert(d.empty());
+}
+
+TEST(deque_concurrent_steal) {
+    // 每個元素恰好被拿走一次
+    const int N = 200000;
+    const int THIEVES = 3;
+    chaseLevDeque<int> d(4);
+    std::vector<std::atomic<int>> seen(N);
+    for (auto& s : seen) s.store(0);
+    std::atomic<bool> done{false};
+    std::atomic<long long> taken{0};
+
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < THIEVES; t++) {
+        thieves.emplace_back([&] {
+            int v;
+            while (!done.load() || !d.empty()) {
+                if (d.steal(v)) {
+                    seen[v].fetch_add(1);
+                    taken.fetch_add(1);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    int v;
+    for (int i = 0; i < N; i++) {
+        d.push(i);
+        if (i % 3 == 0 && d.pop(v)) {
+            seen[v].fetch_add(1);
+            taken.fetch_add(1);
+        }
+    }
+    while (d.pop(v)) {
+        seen[v].fetch_add(1);
+        taken.fetch_add(1);
+    }
+    done.store(true);
+    for (auto& t : thieves) t.join();
+
+    assert(taken.load() == N);
+    for (auto& s : seen) assert(s.load() == 1);
+}
+
+// ============= thread pool 測試 =============
+
+TEST(spawn_and_sync) {
+    workStealingPool pool(4);
+    assert(pool.threadCount() == 4);
+
+    std::atomic<int> sum{0};
+    taskGroup g;
+    for (int i = 1; i <= 100; i++) {
+        pool.spawn(g, [&sum, i] { sum.fetch_add(i); });
+    }
+    pool.sync(g);
+    assert(g.outstanding() == 0);
+    assert(sum.load() == 5050);
+}
+
+TEST(sync_rethrows_task_exception) {
+    workStealingPool pool(2);
+    taskGroup g;
+    std::atomic<int> ran{0};
+    for (int i = 0; i < 10; i++) {
+        pool.spawn(g, [&ran, i] {
+            ran.fetch_add(1);
+            if (i == 5) throw std::runtime_error("task failed");
+        });
+    }
+    try {
+        pool.sync(g);
+        assert(false);
+    } catch (const std::runtime_error&) {
+        // 預期的異常
+    }
+    assert(ran.load() == 10);  // 其他task仍然會執行
+
+    // group可以再次使用
+    pool.spawn(g, [&ran] { ran.fetch_add(1); });
+    pool.sync(g);
+    assert(ran.load() == 11);
+}
+
+TEST(destroy_with_unrun_tasks) {
+    // 每個task都持有token的一份拷貝：pool析構後use_count回到1，表示沒有task被洩漏
+    auto token = std::make_shared<int>(0);
+    std::atomic<bool> spawned{false};
+    std::atomic<int> ran{0};
+    taskGroup g;
+    {
+        auto pool = std::make_unique<workStealingPool>(1);
+        pool->spawn(g, [&, token] {
+            // 唯一的worker在這裡把子task放進自己的deque，然後拖到pool開始析構
+            for (int i = 0; i < 100; i++) pool->spawn(g, [&ran, token] { ran.fetch_add(1); });
+            spawned.store(true);
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        });
+        while (!spawned.load()) std::this_thread::yield();
+        for (int i = 0; i < 100; i++) pool->spawn(g, [&ran, token] { ran.fetch_add(1); });  // 留在injection queue
+        pool.reset();
+    }
+    assert(token.use_count() == 1);
+    assert(g.outstanding() == 0);  // 沒跑的task也要讓group歸零
+    assert(ran.load() < 200);
+}
+
+// ============= 性能測試 =============
+
+static long long fib_serial(int n) {
+    return n < 2 ? n : fib_serial(n - 1) + fib_serial(n - 2);
+}
+
+static long long fib_parallel(workStealingPool& pool, int n) {
+    if (n < 20) return fib_serial(n);  // cutoff：太小的子問題不值得spawn
+    long long a = 0, b = 0;
+    taskGroup g;
+    pool.spawn(g, [&] { a = fib_parallel(pool, n - 1); });
+    b = fib_parallel(pool, n - 2);
+    pool.sync(g);
+    return a + b;
+}
+
+static long long reduce_parallel(workStealingPool& pool, const std::uint32_t* p, std::size_t n) {
+    if (n <= (1u << 16)) return std::accumulate(p, p + n, 0LL);
+    long long left = 0;
+    taskGroup g;
+    pool.spawn(g, [&] { left = reduce_parallel(pool, p, n / 2); });
+    long long right = reduce_parallel(pool, p + n / 2, n - n / 2);
+    pool.sync(g);
+    return left + right;
+}
+
+TEST(parallel_fib_and_reduction) {
+    workStealingPool pool;
+    const int FIB = 36;
+
+    auto t0 = std::chrono::steady_clock::now();
+    long long serial = fib_serial(FIB);
+    auto t1 = std::chrono::steady_clock::now();
+    long long parallel = 0;
+    {
+        taskGroup g;
+        pool.spawn(g, [&] { parallel = fib_parallel(pool, FIB); });
+        pool.sync(g);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    assert(serial == parallel);
+
+    const std::size_t N = 100000000;
+    std::vector<std::uint32_t> data(N);
+    for (std::size_t i = 0; i < N; i++) data[i] = static_cast<std::uint32_t>(i & 1023);
+
+    auto t3 = std::chrono::steady_clock::now();
+    long long serialSum = std::accumulate(data.begin(), data.end(), 0LL);
+    auto t4 = std::chrono::steady_clock::now();
+    long long parallelSum = 0;
+    {
+        taskGroup g;
+        pool.spawn(g, [&] { parallelSum = reduce_parallel(pool, data.data(), N); });
+        pool.sync(g);
+    }
+    auto t5 = std::chrono::steady_clock::now();
+    assert(serialSum == parallelSum);
+
+    auto ms = [](std::chrono::steady_clock::time_point a, std::chrono::steady_clock::time_point b) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(b - a).count();
+    };
+    std::cout << "\n  " << pool.threadCount() << " workers"
+              << "\n  fib(" << FIB << "): serial " << ms(t0, t1) << "ms, pool " << ms(t1, t2) << "ms"
+              << "\n  reduce(" << N << "): serial " << ms(t3, t4) << "ms, pool " << ms(t4, t5) << "ms ";
+}
+
+// ============= 主測試函數 =============
+
+int main() {
+    std::cout << "=== WorkStealingPool 測試套件 ===\n\n";
+
+    // 運行所有測試
+    run_test_deque_owner_lifo_thief_fifo();
+    run_test_deque_concurrent_steal();
+    run_test_spawn_and_sync();
+    run_test_sync_rethrows_task_exception();
+    run_test_destroy_with_unrun_tasks();
+    run_test_parallel_fib_and_reduction();
+
+    // 測試結果
+    std::cout << "\n=== 測試結果 ===\n";
+    std::cout << "通過: " << tests_passed << "/" << tests_total << " 測試\n";
+
+    if (tests_passed == tests_total) {
+        std::cout << "🎉 所有測試通過！\n";
+        return 0;
+    } else {
+        std::cout << "❌ 有 " << (tests_total - tests_passed) << " 個測試失敗\n";
+        return 1;
+    }
+}
@@ -0,0 +1,117 @@
+#ifndef CONTAINER_STATS_CPP
+#define CONTAINER_STATS_CPP
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+// Occupancy and resize telemetry for stack, queue and circularQueue.
+//
+// Each container takes a recorder as its last template parameter and inherits from it
+// privately. statsRecorder<false> is an empty class whose hooks are empty inline
+// functions, so with the empty-base optimisation a container without stats has the
+// same size and code as before. The default recorder is statsRecorder<false> unless
+// CONTAINER_STATS is defined before the container headers are included; either kind
+// can also be named explicitly, e.g. stack<int, statsRecorder<true>>.
+//
+// stats() is available either way and is all zeros when recording is off. The recorded
+// history belongs to the contents: a copy starts with a copy of it, a move takes it
+// (leaving the source at zero) and swap exchanges it.
+struct containerStats{
+    static constexpr int kBuckets = 65;
+
+    std::size_t highWater = 0;          // largest size seen
+    std::size_t resizes = 0;            // buffer reallocations
+    std::size_t bytesMoved = 0;         // element bytes copied / moved by those reallocations
+    std::size_t compactions = 0;        // queue: live elements slid to the front instead of growing
+    std::size_t bytesCompacted = 0;     // element bytes moved by those compactions
+    std::size_t overflowThrows = 0;     // exceptions because the container was full
+    std::size_t underflowThrows = 0;    // exceptions because the container was empty
+    std::size_t histogram[kBuckets] = {};  // size after each insert: bucket 0 for 0,
+                                           // bucket b for [2^(b-1), 2^b)
+
+    static int bucketOf(std::size_t n){
+        return n == 0 ? 0 : 64 - __builtin_clzll(static_cast<unsigned long long>(n));
+    }
+};
+
+template <bool Enabled>
+class statsRecorder;
+
+template <>
+class statsRecorder<false>
+{
+protected:
+    void recordInsert(std::size_t) const{}
+    void recordResize(std::size_t) const{}
+    void recordCompaction(std::size_t) const{}
+    void recordOverflow() const{}
+    void recordUnderflow() const{}
+    void swapStats(statsRecorder&) noexcept{}
+
+public:
+    static constexpr bool statsEnabled = false;
+
+    containerStats stats() const{
+        return containerStats();
+    }
+
+    void resetStats(){}
+};
+
+template <>
+class statsRecorder<true>
+{
+private:
+    // mutable: the const accessors (front, back) also count the throws they make
+    mutable containerStats s;
+
+protected:
+    void recordInsert(std::size_t size) const{
+        if(size > s.highWater){
+            s.highWater = size;
+        }
+        s.histogram[containerStats::bucketOf(size)]++;
+    }
+
+    void recordResize(std::size_t bytes) const{
+        s.resizes++;
+        s.bytesMoved += bytes;
+    }
+
+    void recordCompaction(std::size_t bytes) const{
+        s.compactions++;
+        s.bytesCompacted += bytes;
+    }
+
+    void recordOverflow() const{
+        s.overflowThrows++;
+    }
+
+    void recordUnderflow() const{
+        s.underflowThrows++;
+    }
+
+    void swapStats(statsRecorder& other) noexcept{
+        std::swap(s, other.s);
+    }
+
+public:
+    static constexpr bool statsEnabled = true;
+
+    containerStats stats() const{
+        return s;
+    }
+
+    void resetStats(){
+        s = containerStats();
+    }
+};
+
+#ifdef CONTAINER_STATS
+typedef statsRecorder<true> defaultStatsRecorder;
+#else
+typedef statsRecorder<false> defaultStatsRecorder;
+#endif
+
+#endif
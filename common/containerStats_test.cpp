@@ -0,0 +1,286 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <chrono>
+#include <type_traits>
+
+// 包含你的統計層，以及使用它的三個容器
+#include "containerStats.cpp"
+#include "../stack/stack.cpp"
+#include "../Queue/queue.cpp"  // 它有 using namespace std，所以下面寫 ::queue
+#include "../Queue/circularQueue.cpp"
+
+// 測試計數器
+int tests_passed = 0;
+int tests_total = 0;
+
+// 測試輔助宏
+#define TEST(name) \
+    void test_##name(); \
+    void run_test_##name() { \
+        tests_total++; \
+        std::cout << "Testing " #name "... "; \
+        try { \
+            test_##name(); \
+            tests_passed++; \
+            std::cout << "PASSED\n"; \
+        } catch (const std::exception& e) { \
+            std::cout << "FAILED: " << e.what() << "\n"; \
+        } catch (...) { \
+            std::cout << "FAILED: Unknown exception\n"; \
+        } \
+    } \
+    void test_##name()
+
+typedef statsRecorder<true> on;
+typedef statsRecorder<false> off;
+
+// ============= 編譯期測試 =============
+
+// 關閉時不佔空間：兩者只差一個containerStats
+static_assert(std::is_empty<off>::value, "disabled recorder is empty");
+static_assert(sizeof(stack<int, off>) + sizeof(containerStats) == sizeof(stack<int, on>), "stack pays nothing when off");
+static_assert(sizeof(::queue<int, off>) + sizeof(containerStats) == sizeof(::queue<int, on>), "queue pays nothing when off");
+static_assert(sizeof(circularQueue<int, off>) + sizeof(containerStats) == sizeof(circularQueue<int, on>),
+              "circularQueue pays nothing when off");
+#ifndef CONTAINER_STATS
+static_assert(std::is_same<stack<int>, stack<int, off>>::value, "off unless CONTAINER_STATS is defined");
+#endif
+
+// ============= 基本功能測試 =============
+
+TEST(stack_records) {
+    stack<int, on> s(2);
+    for (int i = 0; i < 10; i++) s.push(i);  // 2 -> 4 -> 8 -> 16
+    containerStats st = s.stats();
+    assert(st.highWater == 10);
+    assert(st.resizes == 3);
+    assert(st.bytesMoved == (2 + 4 + 8) * sizeof(int));
+    assert(st.histogram[1] == 1);   // size 1
+    assert(st.histogram[2] == 2);   // size 2, 3
+    assert(st.histogram[3] == 4);   // size 4..7
+    assert(st.histogram[4] == 3);   // size 8..9
+
+    while (!s.isEmpty()) s.pop();
+    try {
+        s.pop();
+        assert(false);
+    } catch (const std::runtime_error&) {
+        // 預期的異常
+    }
+    try {
+        s.top();
+        assert(false);
+    } catch (const std::runtime_error&) {
+        // 預期的異常
+    }
+    assert(s.stats().underflowThrows == 2);
+    assert(s.stats().highWater == 10);  // 高水位不會因為pop而下降
+
+    s.resetStats();
+    assert(s.stats().highWater == 0 && s.stats().resizes == 0);
+}
+
+TEST(queue_records) {
+    ::queue<std::string, on> q(4);
+    for (int i = 0; i < 6; i++) q.enqueue(std::to_string(i));
+    q.dequeue();
+    q.dequeue();
+    containerStats st = q.stats();
+    assert(st.highWater == 6);
+    assert(st.resizes == 1);
+    assert(st.bytesMoved == 4 * sizeof(std::string));
+
+    while (!q.empty()) q.dequeue();
+    try {
+        q.front();
+        assert(false);
+    } catch (const std::runtime_error&) {
+        // 預期的異常
+    }
+    assert(q.stats().underflowThrows == 1);
+}
+
+// 賦值可能拋出異常的型別，queue只能用複製的方式搬移它
+struct throwingCopy {
+    int v = 0;
+    throwingCopy& operator=(const throwingCopy& o) {
+        v = o.v;
+        return *this;
+    }
+};
+
+TEST(queue_compaction_is_not_a_resize) {
+    ::queue<std::string, on> q(4);
+    for (int i = 0; i < 4; i++) q.enqueue(std::to_string(i));
+    for (int i = 0; i < 3; i++) q.dequeue();
+    q.enqueue("4");  // 前面3格是空的：原地往前搬，不擴容
+    assert(q.capacity() == 4 && q.front() == "3");
+    assert(q.stats().resizes == 0 && q.stats().bytesMoved == 0);
+    assert(q.stats().compactions == 1 && q.stats().bytesCompacted == sizeof(std::string));
+
+    ::queue<throwingCopy, on> c(4);
+    for (int i = 0; i < 4; i++) c.enqueue(throwingCopy{i});
+    for (int i = 0; i < 3; i++) c.dequeue();
+    c.enqueue(throwingCopy{4});  // 用複製的方式原地搬，一樣算compaction
+    assert(c.capacity() == 4 && c.front().v == 3 && c.back().v == 4);
+    assert(c.stats().resizes == 0 && c.stats().compactions == 1);
+}
+
+TEST(circular_queue_records) {
+    circularQueue<int, on> c(4);
+    for (int i = 0; i < 4; i++) c.enqueue(i);
+    try {
+        c.enqueue(4);
+        assert(false);
+    } catch (const std::overflow_error&) {
+        // 預期的異常
+    }
+    c.clear();
+    try {
+        c.dequeue();
+        assert(false);
+    } catch (const std::underflow_error&) {
+        // 預期的異常
+    }
+    try {
+        c.front();  // front/back也是underflow_error，一樣計入
+        assert(false);
+    } catch (const std::underflow_error&) {
+        // 預期的異常
+    }
+    try {
+        c.commit_write(5);
+        assert(false);
+    } catch (const std::overflow_error&) {
+        // 預期的異常
+    }
+
+    c.setOverflowMode(ringMode::grow);
+    int src[9] = {};
+    c.enqueue_bulk(src, 9);  // 一次擴容
+    containerStats st = c.stats();
+    assert(st.overflowThrows == 2 && st.underflowThrows == 2);
+    assert(st.highWater == 9 && st.resizes == 1);
+    assert(st.histogram[containerStats::bucketOf(9)] == 1);
+
+    circularQueue<int, off> quiet(1);
+    quiet.enqueue(1);
+    assert(quiet.stats().highWater == 0);  // 關閉時永遠是0
+    assert(!quiet.statsEnabled && c.statsEnabled);
+}
+
+// 統計跟著內容走：複製是一份拷貝，移動會帶走(來源歸零)，swap互換
+template <typename C, typename Add>
+static void checkStatsFollowContents(Add add) {
+    C a(4), b(4);
+    for (int i = 0; i < 3; i++) add(a, i);
+    add(b, 0);
+    containerStats sa = a.stats();
+    assert(sa.highWater == 3 && b.stats().highWater == 1);
+
+    C copy(a);
+    assert(copy.stats().highWater == 3);
+    assert(copy.stats().histogram[2] == sa.histogram[2]);  // 沒有重新記錄每個元素
+
+    C moved(std::move(copy));
+    assert(moved.stats().highWater == 3 && copy.stats().highWater == 0);
+
+    a.swap(b);
+    assert(a.stats().highWater == 1 && b.stats().highWater == 3);
+
+    a = std::move(b);  // 不會留下a原本的統計
+    assert(a.stats().highWater == 3);
+
+    a = moved;
+    assert(a.stats().highWater == 3 && moved.stats().highWater == 3);
+}
+
+TEST(stats_follow_copy_move_swap) {
+    checkStatsFollowContents<stack<int, on>>([](stack<int, on>& s, int v) { s.push(v); });
+    checkStatsFollowContents<::queue<int, on>>([](::queue<int, on>& q, int v) { q.enqueue(v); });
+    checkStatsFollowContents<circularQueue<int, on>>([](circularQueue<int, on>& c, int v) { c.enqueue(v); });
+
+    circularQueue<int, on> ring(3);
+    for (int i = 0; i < 5; i++) {
+        if (ring.isFull()) ring.dequeue();
+        ring.enqueue(i);  // 繞過結尾
+    }
+    circularQueue<int, on> copy(ring);
+    assert(copy.size() == 3 && copy.front() == 2 && copy.back() == 4);
+    copy.dequeue();
+    copy.enqueue(5);  // 複製出來的ring從頭排好，rearIdx也正確
+    assert(copy.front() == 3 && copy.back() == 5 && copy.size() == 3);
+}
+
+// ============= 性能測試 =============
+
+template <typename Stack>
+static double pushPop(int rounds, long long& sum) {
+    auto t0 = std::chrono::steady_clock::now();
+    Stack s(16);
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < 1000; i++) s.push(i);
+        while (!s.isEmpty()) {
+            sum += s.top();
+            s.pop();
+        }
+    }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / (rounds * 2000.0);
+}
+
+template <typename Ring>
+static double churn(int ops, long long& sum) {
+    auto t0 = std::chrono::steady_clock::now();
+    Ring c(1024);
+    for (int i = 0; i < ops; i++) {
+        if (c.isFull()) {
+            sum += c.front();
+            c.dequeue();
+        }
+        c.enqueue(i);
+    }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / ops;
+}
+
+TEST(overhead_on_vs_off) {
+    long long a = 0, b = 0, c = 0, d = 0;
+    pushPop<stack<int, off>>(2000, a);  // 預熱
+    double stackOff = pushPop<stack<int, off>>(20000, a);
+    double stackOn = pushPop<stack<int, on>>(20000, b);
+    double ringOff = churn<circularQueue<int, off>>(20000000, c);
+    double ringOn = churn<circularQueue<int, on>>(20000000, d);
+    assert(a > 0 && b > 0 && c == d);
+
+    std::cout << "\n  stack push+pop: stats off " << stackOff << " ns/op, on " << stackOn << " ns/op"
+              << "\n  circularQueue churn: stats off " << ringOff << " ns/op, on " << ringOn << " ns/op ";
+}
+
+// ============= 主測試函數 =============
+
+int main() {
+    std::cout << "=== ContainerStats 測試套件 ===\n\n";
+
+    // 運行所有測試
+    run_test_stack_records();
+    run_test_queue_records();
+    run_test_queue_compaction_is_not_a_resize();
+    run_test_circular_queue_records();
+    run_test_stats_follow_copy_move_swap();
+    run_test_overhead_on_vs_off();
+
+    // 測試結果
+    std::cout << "\n=== 測試結果 ===\n";
+    std::cout << "通過: " << tests_passed << "/" << tests_total << " 測試\n";
+
+    if (tests_passed == tests_total) {
+        std::cout << "🎉 所有測試通過！\n";
+        return 0;
+    } else {
+        std::cout << "❌ 有 " << (tests_total - tests_passed) << " 個測試失敗\n";
+        return 1;
+    }
+}
@@ -0,0 +1,140 @@
+#ifndef MAPPED_BUFFER_CPP
+#define MAPPED_BUFFER_CPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cerrno>
+#include <new>
+#include <system_error>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// Element buffers for stack / queue that can come either from new T[] or from an
+// anonymous mmap set up by reserve(): 2 MiB aligned and advised MADV_HUGEPAGE so
+// transparent huge pages can back it, optionally mlock'ed, and pre-touched so the
+// page faults happen inside reserve() instead of on the first push. The flags travel
+// with the container so later growth keeps allocating the same way.
+// Outside Linux every request falls back to new T[].
+namespace mappedBuffer{
+
+enum : std::uint8_t{
+    mapped = 1,     // 0 means new T[] / delete []
+    huge = 2,
+    locked = 4,
+    prefault = 8,
+};
+
+constexpr std::size_t kPage = 4096;
+constexpr std::size_t kHugePage = std::size_t(2) << 20;
+
+inline std::size_t mappedLength(std::size_t bytes, std::uint8_t flags){
+    std::size_t unit = (flags & huge) ? kHugePage : kPage;
+    if(bytes == 0){
+        bytes = 1;
+    }
+    return (bytes + unit - 1) / unit * unit;
+}
+
+#ifdef __linux__
+
+inline void unmap(void* p, std::size_t bytes, std::uint8_t flags){
+    munmap(p, mappedLength(bytes, flags));
+}
+
+inline void* map(std::size_t bytes, std::uint8_t flags){
+    std::size_t len = mappedLength(bytes, flags);
+    std::size_t slack = (flags & huge) ? kHugePage : 0;
+
+    // over-map by one huge page and trim, so the region starts on a 2 MiB boundary
+    void* raw = mmap(nullptr, len + slack, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(raw == MAP_FAILED){
+        throw std::system_error(errno, std::generic_category(), "mmap");
+    }
+    char* base = static_cast<char*>(raw);
+    char* p = base;
+    if(slack != 0){
+        std::uintptr_t addr = reinterpret_cast<std::uintptr_t>(base);
+        p = base + ((kHugePage - addr % kHugePage) % kHugePage);
+        if(p != base){
+            munmap(base, p - base);
+        }
+        std::size_t tail = (base + len + slack) - (p + len);
+        if(tail != 0){
+            munmap(p + len, tail);
+        }
+        // advisory only: with THP off the mapping simply stays on 4 KiB pages
+        madvise(p, len, MADV_HUGEPAGE);
+    }
+    if((flags & locked) && mlock(p, len) != 0){
+        int err = errno;
+        munmap(p, len);
+        throw std::system_error(err, std::generic_category(), "mlock");
+    }
+    if(flags & prefault){
+        // one write per 4 KiB page; with huge pages the first write of each 2 MiB
+        // already faults in the whole page and the rest are TLB hits
+        for(std::size_t off = 0; off < len; off += kPage){
+            static_cast<volatile char*>(static_cast<void*>(p))[off] = 0;
+        }
+    }
+    return p;
+}
+
+#else
+
+inline void unmap(void* p, std::size_t, std::uint8_t){
+    ::operator delete(p);
+}
+
+inline void* map(std::size_t bytes, std::uint8_t){
+    return ::operator new(bytes);
+}
+
+#endif
+
+// n default-initialised elements, like new T[n]
+template <typename T>
+T* allocate(std::size_t n, std::uint8_t flags){
+    if(!(flags & mapped)){
+        return new T[n];
+    }
+    T* p = static_cast<T*>(map(n * sizeof(T), flags));
+    std::size_t built = 0;
+    try
+    {
+        for(; built < n; built++){
+            new (p + built) T;
+        }
+    }
+    catch(...)
+    {
+        while(built > 0){
+            p[--built].~T();
+        }
+        unmap(p, n * sizeof(T), flags);
+        throw;
+    }
+    return p;
+}
+
+template <typename T>
+void release(T* p, std::size_t n, std::uint8_t flags){
+    if(!(flags & mapped)){
+        delete [] p;
+        return;
+    }
+    if(p == nullptr){
+        return;
+    }
+    for(std::size_t i = 0; i < n; i++){
+        p[i].~T();
+    }
+    unmap(p, n * sizeof(T), flags);
+}
+
+}
+
+#endif
@@ -0,0 +1,249 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <chrono>
+#include <fstream>
+#include <cstring>
+#include <cstdint>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+// 包含你的mmap緩衝區實現，以及使用它的stack和queue
+#include "mappedBuffer.cpp"
+#include "../stack/stack.cpp"
+#include "../Queue/queue.cpp"  // 它有 using namespace std，所以下面寫 ::queue
+
+// 測試計數器
+int tests_passed = 0;
+int tests_total = 0;
+
+// 測試輔助宏
+#define TEST(name) \
+    void test_##name(); \
+    void run_test_##name() { \
+        tests_total++; \
+        std::cout << "Testing " #name "... "; \
+        try { \
+            test_##name(); \
+            tests_passed++; \
+            std::cout << "PASSED\n"; \
+        } catch (const std::exception& e) { \
+            std::cout << "FAILED: " << e.what() << "\n"; \
+        } catch (...) { \
+            std::cout << "FAILED: Unknown exception\n"; \
+        } \
+    } \
+    void test_##name()
+
+// 輔助：perf計數器，打不開時(容器、perf_event_paranoid)退回getrusage的minor faults
+class faultCounter {
+    int faultsFd = -1, tlbFd = -1;
+    long startMinflt = 0;
+
+    static int open(std::uint32_t type, std::uint64_t config) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_hv = 1;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    static long long read(int fd) {
+        long long v = 0;
+        if (fd < 0 || ::read(fd, &v, sizeof(v)) != sizeof(v)) return -1;
+        return v;
+    }
+
+    static long minflt() {
+        rusage ru;
+        getrusage(RUSAGE_SELF, &ru);
+        return ru.ru_minflt;
+    }
+
+public:
+    faultCounter() {
+        faultsFd = open(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS);
+        tlbFd = open(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                             (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+    }
+
+    ~faultCounter() {
+        if (faultsFd >= 0) close(faultsFd);
+        if (tlbFd >= 0) close(tlbFd);
+    }
+
+    void start() {
+        for (int fd : {faultsFd, tlbFd}) {
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+        startMinflt = minflt();
+    }
+
+    // faults: perf或rusage；dTLB misses：沒有硬體計數器時為-1
+    void stop(long long& faults, long long& tlbMisses) {
+        for (int fd : {faultsFd, tlbFd}) {
+            if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+        faults = faultsFd >= 0 ? read(faultsFd) : minflt() - startMinflt;
+        tlbMisses = read(tlbFd);
+    }
+
+    const char* source() const { return faultsFd >= 0 ? "perf" : "getrusage"; }
+};
+
+// 輔助：這個process目前有多少KiB的透明大頁
+static long anonHugeKiB() {
+    std::ifstream in("/proc/self/smaps_rollup");
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.compare(0, 14, "AnonHugePages:") == 0) return std::stol(line.substr(14));
+    }
+    return -1;
+}
+
+// ============= 基本功能測試 =============
+
+TEST(stack_reserve_keeps_contents) {
+    stack<std::string> s(4);
+    for (int i = 0; i < 10; i++) s.push(std::to_string(i));
+    s.reserve(100000);  // 移到mmap緩衝區
+    assert(s.size() == 10);
+    assert(s.top() == "9");
+    assert(s.capacity() >= 100000);
+    assert(s.capacity() * sizeof(std::string) % mappedBuffer::kHugePage == 0);  // 用滿整個mapping
+
+    for (int i = 10; i < 200000; i++) s.push(std::to_string(i));  // 超過保留量後照樣擴容
+    stack<std::string> copy(s);
+    stack<std::string> moved(std::move(copy));
+    for (int i = 199999; i >= 0; i--) {
+        assert(moved.top() == std::to_string(i));
+        moved.pop();
+    }
+
+    stack<int> small(1);
+    small.reserve(10, false, false);  // 不預先觸碰、不要大頁：4 KiB對齊
+    assert(small.capacity() == mappedBuffer::kPage / sizeof(int));
+    small.push(1);
+    small.reserve(5, false, false);  // 已經夠大，不動
+    assert(small.capacity() == mappedBuffer::kPage / sizeof(int) && small.top() == 1);
+}
+
+TEST(queue_reserve_compacts) {
+    ::queue<int> q(8);
+    for (int i = 0; i < 8; i++) q.enqueue(i);
+    for (int i = 0; i < 5; i++) q.dequeue();
+    q.reserve(1 << 20);
+    assert(q.size() == 3 && q.front() == 5 && q.back() == 7);
+    assert(q.capacity() >= (1 << 20));  // 和stack一樣：capacity()是整個緩衝區
+    for (int i = 8; i < (1 << 21); i++) q.enqueue(i);
+    for (int i = 5; i < (1 << 21); i++) {
+        assert(q.front() == i);
+        q.dequeue();
+    }
+
+    ::queue<int> other(1);
+    other.enqueue(42);
+    q.swap(other);  // 交換時mapping跟著走
+    assert(q.front() == 42 && other.empty());
+}
+
+TEST(mlock_failure_keeps_buffer) {
+    rlimit rl;
+    getrlimit(RLIMIT_MEMLOCK, &rl);
+    stack<char> s(1);
+    s.push('a');
+    try {
+        s.reserve(16u << 20, true, true, true);
+        assert(s.capacity() >= (16u << 20));  // root或RLIMIT_MEMLOCK夠大時鎖得住
+    } catch (const std::system_error&) {
+        // 預期的異常：超過RLIMIT_MEMLOCK
+        assert(rl.rlim_cur != RLIM_INFINITY);
+        assert(s.capacity() == 1);  // 失敗時原本的緩衝區不變
+    }
+    assert(s.top() == 'a');
+    s.reserve(4096, true, false, true);
+    s.push('x');
+    assert(s.top() == 'x' && s.size() == 2);
+}
+
+// ============= 性能測試 =============
+
+TEST(prefault_vs_first_touch) {
+    const std::size_t N = std::size_t(32) << 20;  // 32M個int = 128 MiB
+    faultCounter pc;
+    long long faults, tlb;
+
+    auto run = [&](const char* label, auto& s, bool reserve) {
+        auto t0 = std::chrono::steady_clock::now();
+        long long rf = 0, rt = 0;
+        if (reserve) {
+            pc.start();
+            s.reserve(N);
+            pc.stop(rf, rt);
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        pc.start();
+        for (std::size_t i = 0; i < N; i++) s.push(static_cast<int>(i));
+        long long sum = 0;
+        while (!s.isEmpty()) {
+            sum += s.top();
+            s.pop();
+        }
+        pc.stop(faults, tlb);
+        auto t2 = std::chrono::steady_clock::now();
+        assert(sum == static_cast<long long>(N) * (N - 1) / 2);
+        std::cout << "\n  " << label << ": push+pop " << std::chrono::duration<double, std::milli>(t2 - t1).count()
+                  << "ms, " << faults << " faults, dTLB misses " << (tlb < 0 ? std::string("n/a") : std::to_string(tlb));
+        if (reserve) {
+            std::cout << " (reserve " << std::chrono::duration<double, std::milli>(t1 - t0).count() << "ms, " << rf
+                      << " faults, AnonHugePages " << anonHugeKiB() << " KiB)";
+        }
+    };
+
+    std::cout << "\n  (counters from " << pc.source() << ")";
+    {
+        stack<int> grown(16);
+        run("stack grown on demand", grown, false);
+    }
+    {
+        stack<int> reserved(16);
+        run("stack reserve(N)     ", reserved, true);
+    }
+    std::cout << " ";
+}
+
+// ============= 主測試函數 =============
+
+int main() {
+    std::cout << "=== MappedBuffer 測試套件 ===\n\n";
+
+    // 運行所有測試
+    run_test_stack_reserve_keeps_contents();
+    run_test_queue_reserve_compacts();
+    run_test_mlock_failure_keeps_buffer();
+    run_test_prefault_vs_first_touch();
+
+    // 測試結果
+    std::cout << "\n=== 測試結果 ===\n";
+    std::cout << "通過: " << tests_passed << "/" << tests_total << " 測試\n";
+
+    if (tests_passed == tests_total) {
+        std::cout << "🎉 所有測試通過！\n";
+        return 0;
+    } else {
+        std::cout << "❌ 有 " << (tests_total - tests_passed) << " 個測試失敗\n";
+        return 1;
+    }
+}
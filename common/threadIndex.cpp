@@ -0,0 +1,57 @@
+#ifndef THREAD_INDEX_CPP
+#define THREAD_INDEX_CPP
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+// Small dense index per live thread, shared by every user: flatCombining's per-thread
+// slots, shardedQueue's home shard. Indices are recycled when a thread exits, so a
+// program that keeps spawning short-lived threads only needs as many indices as it has
+// threads alive at once.
+class threadIndex
+{
+private:
+    static std::mutex& freeLock(){
+        static std::mutex m;
+        return m;
+    }
+
+    static std::vector<std::size_t>& freeList(){
+        static std::vector<std::size_t> v;
+        return v;
+    }
+
+    static std::size_t& nextIndex(){
+        static std::size_t n = 0;
+        return n;
+    }
+
+    struct holder{
+        std::size_t idx;
+
+        holder(){
+            std::lock_guard<std::mutex> lock(freeLock());
+            if(freeList().empty()){
+                idx = nextIndex()++;
+            }
+            else{
+                idx = freeList().back();
+                freeList().pop_back();
+            }
+        }
+
+        ~holder(){
+            std::lock_guard<std::mutex> lock(freeLock());
+            freeList().push_back(idx);
+        }
+    };
+
+public:
+    static std::size_t get(){
+        static thread_local holder h;
+        return h.idx;
+    }
+};
+
+#endif
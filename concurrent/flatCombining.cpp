@@ -0,0 +1,210 @@
+#include <iostream>
+#include <utility>
+#include <stdexcept>
+#include <atomic>
+#include <exception>
+#include <type_traits>
+#include <memory>
+#include <optional>
+#include <mutex>
+#include <vector>
+#include <thread>
+#include <cstdint>
+
+#include "../common/threadIndex.cpp"
+
+// Flat combining around any sequential container: a thread publishes its operation in
+// its own slot and then either waits for it to be done or, if the lock is free, becomes
+// the combiner and runs every pending operation in one pass. One thread touches the
+// container at a time, so it stays hot in that core's cache, and a lock holder that gets
+// preempted does not stall the others behind a convoy -- their requests are already
+// published and the next combiner picks them up.
+//
+//     flatCombining<stack<int>> s(1024);
+//     s.apply([](stack<int>& st){ st.push(42); });
+//     int v = s.apply([](stack<int>& st){ int x = st.top(); st.pop(); return x; });
+//
+// apply() returns the operation's result by value (a reference would outlive the
+// combiner's exclusive access) and rethrows in the caller whatever the operation threw.
+// Slots are indexed by the process-wide threadIndex; a thread whose index is MaxThreads
+// or more has no slot and simply waits for the lock and runs its own operation.
+template <typename Container, std::size_t MaxThreads = 128>
+class flatCombining
+{
+private:
+    struct alignas(64) slot{
+        std::atomic<bool> pending{false};
+        void (*run)(Container&, void*) = nullptr;
+        void* arg = nullptr;
+        std::exception_ptr error;
+    };
+
+    Container container;
+    alignas(64) std::atomic<bool> locked{false};
+    std::atomic<std::size_t> used{0};
+    std::atomic<std::uint64_t> passes{0};
+    std::atomic<std::uint64_t> applied{0};
+    std::unique_ptr<slot[]> slots;
+
+    // a few passes per lock hold catch requests published while the first pass ran
+    static constexpr int kPasses = 3;
+
+    template <typename Fn, typename R>
+    struct request{
+        Fn& fn;
+        std::optional<R> result;
+
+        explicit request(Fn& fn) : fn(fn){}
+
+        static void call(Container& c, void* p){
+            request* self = static_cast<request*>(p);
+            self->result.emplace(self->fn(c));
+        }
+
+        R take(){
+            return std::move(*result);
+        }
+    };
+
+    template <typename Fn>
+    struct request<Fn, void>{
+        Fn& fn;
+
+        explicit request(Fn& fn) : fn(fn){}
+
+        static void call(Container& c, void* p){
+            static_cast<request*>(p)->fn(c);
+        }
+
+        void take(){}
+    };
+
+    bool tryLock(){
+        return !locked.load(std::memory_order_relaxed) &&
+               !locked.exchange(true, std::memory_order_acquire);
+    }
+
+    // done: operations the lock holder already ran itself
+    void combine(std::uint64_t done = 0){
+        for(int p = 0; p < kPasses; p++){
+            std::size_t n = used.load(std::memory_order_acquire);
+            std::uint64_t before = done;
+            for(std::size_t i = 0; i < n; i++){
+                slot& s = slots[i];
+                if(!s.pending.load(std::memory_order_acquire)){
+                    continue;
+                }
+                try
+                {
+                    s.run(container, s.arg);
+                }
+                catch(...)
+                {
+                    s.error = std::current_exception();
+                }
+                s.pending.store(false, std::memory_order_release);
+                done++;
+            }
+            if(done == before){
+                break;
+            }
+        }
+        passes.fetch_add(1, std::memory_order_relaxed);
+        applied.fetch_add(done, std::memory_order_relaxed);
+    }
+
+    // nullptr if the calling thread's index is past the slot array
+    slot* mySlot(){
+        std::size_t idx = threadIndex::get();
+        if(idx >= MaxThreads){
+            return nullptr;
+        }
+        std::size_t n = used.load(std::memory_order_relaxed);
+        while(n <= idx && !used.compare_exchange_weak(n, idx + 1, std::memory_order_release)){
+        }
+        return &slots[idx];
+    }
+
+    // with the lock held: run req directly, then serve whoever published meanwhile
+    template <typename Fn, typename R>
+    R runHeld(request<Fn, R>& req){
+        std::exception_ptr error;
+        try
+        {
+            request<Fn, R>::call(container, &req);
+        }
+        catch(...)
+        {
+            error = std::current_exception();
+        }
+        combine(1);
+        locked.store(false, std::memory_order_release);
+        if(error){
+            std::rethrow_exception(error);
+        }
+        return req.take();
+    }
+
+public:
+    // ctor, forwards its arguments to the container
+    template <typename... Args>
+    explicit flatCombining(Args&&... args)
+        : container(std::forward<Args>(args)...), slots(new slot[MaxThreads]){}
+
+    flatCombining(const flatCombining&) = delete;
+    flatCombining& operator=(const flatCombining&) = delete;
+
+    template <typename Fn>
+    auto apply(Fn fn) -> typename std::decay<decltype(fn(std::declval<Container&>()))>::type{
+        typedef typename std::decay<decltype(fn(std::declval<Container&>()))>::type R;
+        request<Fn, R> req(fn);
+
+        if(tryLock()){
+            return runHeld(req);
+        }
+
+        slot* mine = mySlot();
+        if(mine == nullptr){
+            // no slot to publish in: take the lock like a plain spin lock
+            while(!tryLock()){
+                std::this_thread::yield();
+            }
+            return runHeld(req);
+        }
+
+        slot& s = *mine;
+        s.run = &request<Fn, R>::call;
+        s.arg = &req;
+        s.error = nullptr;
+        s.pending.store(true, std::memory_order_release);
+
+        while(s.pending.load(std::memory_order_acquire)){
+            if(tryLock()){
+                combine();
+                locked.store(false, std::memory_order_release);
+            }
+            else{
+                std::this_thread::yield();
+            }
+        }
+        if(s.error){
+            std::rethrow_exception(std::exchange(s.error, nullptr));
+        }
+        return req.take();
+    }
+
+    // number of lock holds and operations they ran; operations() / combines() is the
+    // average batch size
+    std::uint64_t combines() const{
+        return passes.load(std::memory_order_relaxed);
+    }
+
+    std::uint64_t operations() const{
+        return applied.load(std::memory_order_relaxed);
+    }
+
+    // direct access, only safe while no other thread calls apply()
+    Container& unsafeGet(){
+        return container;
+    }
+};
@@ -0,0 +1,266 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <random>
+#include <cstdint>
+
+// 包含你的flat combining實現，以及被包裝的原有容器
+#include "flatCombining.cpp"
+#include "../stack/stack.cpp"
+#include "../Queue/queue.cpp"  // 它有 using namespace std，所以下面寫 ::queue
+#include "../Queue/mpmcRing.cpp"
+#include "../BinaryTree/AVL_tree.cpp"
+
+// 測試計數器
+int tests_passed = 0;
+int tests_total = 0;
+
+// 測試輔助宏
+#define TEST(name) \
+    void test_##name(); \
+    void run_test_##name() { \
+        tests_total++; \
+        std::cout << "Testing " #name "... "; \
+        try { \
+            test_##name(); \
+            tests_passed++; \
+            std::cout << "PASSED\n"; \
+        } catch (const std::exception& e) { \
+            std::cout << "FAILED: " << e.what() << "\n"; \
+        } catch (...) { \
+            std::cout << "FAILED: Unknown exception\n"; \
+        } \
+    } \
+    void test_##name()
+
+// ============= 基本功能測試 =============
+
+TEST(single_thread_results_and_exceptions) {
+    flatCombining<stack<std::string>> s(4);  // 參數轉給stack的ctor
+    s.apply([](stack<std::string>& st) { st.push("a"); });
+    s.apply([](stack<std::string>& st) { st.push("b"); });
+    std::string top = s.apply([](stack<std::string>& st) {
+        std::string v = st.top();
+        st.pop();
+        return v;
+    });
+    assert(top == "b");
+    assert(s.apply([](stack<std::string>& st) { return st.size(); }) == 1);
+
+    s.apply([](stack<std::string>& st) { st.pop(); });
+    try {
+        s.apply([](stack<std::string>& st) { st.pop(); });  // 空stack，例外要傳回呼叫端
+        assert(false);
+    } catch (const std::runtime_error&) {
+        // 預期的異常
+    }
+    assert(s.apply([](stack<std::string>& st) { return st.isEmpty(); }));
+    assert(s.operations() == s.combines());  // 單執行緒時每批只有自己一個操作
+}
+
+TEST(concurrent_stack_conserves_elements) {
+    const int THREADS = 4, PER = 20000;
+    flatCombining<stack<std::uint64_t>> s(16);
+    std::atomic<std::uint64_t> popped{0};
+
+    std::vector<std::thread> ts;
+    for (int t = 0; t < THREADS; t++) {
+        ts.emplace_back([&, t] {
+            for (int i = 0; i < PER; i++) {
+                std::uint64_t v = std::uint64_t(t) * PER + i;
+                s.apply([v](stack<std::uint64_t>& st) { st.push(v); });
+                if (i % 2 == 1) {
+                    popped.fetch_add(s.apply([](stack<std::uint64_t>& st) {
+                        std::uint64_t x = st.top();
+                        st.pop();
+                        return x;
+                    }));
+                }
+            }
+        });
+    }
+    for (auto& th : ts) th.join();
+
+    stack<std::uint64_t>& rest = s.unsafeGet();
+    std::uint64_t sum = popped.load();
+    while (!rest.isEmpty()) {
+        sum += rest.top();
+        rest.pop();
+    }
+    const std::uint64_t n = std::uint64_t(THREADS) * PER;
+    assert(sum == n * (n - 1) / 2);
+    assert(s.operations() == n + n / 2);
+}
+
+TEST(more_threads_than_slots) {
+    // 只有1個slot：拿不到slot的thread改成直接等鎖，不會拋出異常
+    const int THREADS = 4, PER = 5000;
+    flatCombining<stack<std::uint64_t>, 1> s(16);
+    std::vector<std::thread> ts;
+    for (int t = 0; t < THREADS; t++) {
+        ts.emplace_back([&, t] {
+            for (int i = 0; i < PER; i++) {
+                std::uint64_t v = std::uint64_t(t) * PER + i;
+                s.apply([v](stack<std::uint64_t>& st) { st.push(v); });
+            }
+            try {
+                s.apply([](stack<std::uint64_t>&) -> int { throw std::runtime_error("op failed"); });
+                assert(false);
+            } catch (const std::runtime_error&) {
+                // 預期的異常
+            }
+        });
+    }
+    for (auto& th : ts) th.join();
+
+    stack<std::uint64_t>& rest = s.unsafeGet();
+    std::uint64_t sum = 0;
+    while (!rest.isEmpty()) {
+        sum += rest.top();
+        rest.pop();
+    }
+    const std::uint64_t n = std::uint64_t(THREADS) * PER;
+    assert(sum == n * (n - 1) / 2);
+}
+
+TEST(queue_and_avl_unchanged) {
+    flatCombining<::queue<int>> q(8);
+    flatCombining<AVL_Tree> tree;
+    const int THREADS = 4, PER = 5000;
+
+    std::vector<std::thread> ts;
+    for (int t = 0; t < THREADS; t++) {
+        ts.emplace_back([&, t] {
+            for (int i = 0; i < PER; i++) {
+                int v = t * PER + i;
+                q.apply([v](::queue<int>& qu) { qu.enqueue(v); });
+                tree.apply([v](AVL_Tree& tr) { tr.insert(v); });
+            }
+        });
+    }
+    for (auto& th : ts) th.join();
+
+    assert(q.apply([](::queue<int>& qu) { return qu.size(); }) == std::size_t(THREADS * PER));
+    for (int v = 0; v < THREADS * PER; v += 97) {
+        assert(tree.apply([v](AVL_Tree& tr) { return tr.find(v); }));
+    }
+    assert(!tree.apply([](AVL_Tree& tr) { return tr.find(-1); }));
+    assert(tree.apply([](AVL_Tree& tr) { return tr.isAVL(); }));
+}
+
+// ============= 性能測試 =============
+
+// 每個thread做opsPerThread次op(t, i)，回傳每秒操作數(百萬)
+template <typename Op>
+static double throughput(int threads, int opsPerThread, Op op) {
+    std::atomic<bool> go{false};
+    std::vector<std::thread> ts;
+    for (int t = 0; t < threads; t++) {
+        ts.emplace_back([&, t] {
+            while (!go.load()) std::this_thread::yield();
+            for (int i = 0; i < opsPerThread; i++) op(t, i);
+        });
+    }
+    auto t0 = std::chrono::steady_clock::now();
+    go.store(true);
+    for (auto& th : ts) th.join();
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return threads * double(opsPerThread) / s / 1e6;
+}
+
+TEST(combining_vs_mutex_vs_lock_free) {
+    const int OPS = 400000;
+    std::cout << "\n  (" << std::thread::hardware_concurrency() << " hardware threads, Mops/s)";
+
+    for (int threads : {1, 2, 4, 8}) {
+        const int per = OPS / threads;
+
+        // stack: 交替push/pop
+        flatCombining<stack<int>> fcStack(1024);
+        double fcS = throughput(threads, per, [&](int, int i) {
+            if (i % 2 == 0) fcStack.apply([i](stack<int>& st) { st.push(i); });
+            else fcStack.apply([](stack<int>& st) { if (!st.isEmpty()) st.pop(); });
+        });
+        stack<int> lockedStack(1024);
+        std::mutex ms;
+        double muS = throughput(threads, per, [&](int, int i) {
+            std::lock_guard<std::mutex> lock(ms);
+            if (i % 2 == 0) lockedStack.push(i);
+            else if (!lockedStack.isEmpty()) lockedStack.pop();
+        });
+
+        // queue: 對照lock-free的mpmcRing
+        flatCombining<::queue<int>> fcQueue(1024);
+        double fcQ = throughput(threads, per, [&](int, int i) {
+            if (i % 2 == 0) fcQueue.apply([i](::queue<int>& qu) { qu.enqueue(i); });
+            else fcQueue.apply([](::queue<int>& qu) { if (!qu.empty()) qu.dequeue(); });
+        });
+        ::queue<int> lockedQueue(1024);
+        std::mutex mq;
+        double muQ = throughput(threads, per, [&](int, int i) {
+            std::lock_guard<std::mutex> lock(mq);
+            if (i % 2 == 0) lockedQueue.enqueue(i);
+            else if (!lockedQueue.empty()) lockedQueue.dequeue();
+        });
+        mpmcRing<int> ring(1 << 16);
+        double lf = throughput(threads, per, [&](int, int i) {
+            int out;
+            if (i % 2 == 0) ring.tryEnqueue(i);
+            else ring.tryDequeue(out);
+        });
+
+        // AVL: 3/4 find，1/4 insert
+        flatCombining<AVL_Tree> fcTree;
+        AVL_Tree lockedTree;
+        std::mutex mt;
+        double fcT = throughput(threads, per / 4, [&](int t, int i) {
+            int v = (t * 7919 + i * 31) % 100000;
+            if (i % 4 == 0) fcTree.apply([v](AVL_Tree& tr) { tr.insert(v); });
+            else fcTree.apply([v](AVL_Tree& tr) { return tr.find(v); });
+        });
+        double muT = throughput(threads, per / 4, [&](int t, int i) {
+            int v = (t * 7919 + i * 31) % 100000;
+            std::lock_guard<std::mutex> lock(mt);
+            if (i % 4 == 0) lockedTree.insert(v);
+            else lockedTree.find(v);
+        });
+
+        std::cout << "\n  " << threads << " threads: stack fc " << fcS << " / mutex " << muS
+                  << ", queue fc " << fcQ << " / mutex " << muQ << " / mpmcRing " << lf
+                  << ", AVL fc " << fcT << " / mutex " << muT
+                  << "  (avg batch " << double(fcStack.operations()) / double(fcStack.combines()) << ")";
+    }
+    std::cout << " ";
+}
+
+// ============= 主測試函數 =============
+
+int main() {
+    std::cout << "=== FlatCombining 測試套件 ===\n\n";
+
+    // 運行所有測試
+    run_test_single_thread_results_and_exceptions();
+    run_test_concurrent_stack_conserves_elements();
+    run_test_more_threads_than_slots();
+    run_test_queue_and_avl_unchanged();
+    run_test_combining_vs_mutex_vs_lock_free();
+
+    // 測試結果
+    std::cout << "\n=== 測試結果 ===\n";
+    std::cout << "通過: " << tests_passed << "/" << tests_total << " 測試\n";
+
+    if (tests_passed == tests_total) {
+        std::cout << "🎉 所有測試通過！\n";
+        return 0;
+    } else {
+        std::cout << "❌ 有 " << (tests_total - tests_passed) << " 個測試失敗\n";
+        return 1;
+    }
+}
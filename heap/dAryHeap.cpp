@@ -0,0 +1,358 @@
+#include <iostream>
+#include <utility>
+#include <stdexcept>
+#include <limits>
+#include <type_traits>
+#include <functional>
+#include <vector>
+#include <cstdint>
+
+// d-ary min-heap (by Compare) on a contiguous array. Node i's children are
+// D*i+1 .. D*i+D, so a larger D makes the tree shallower: push does fewer moves and
+// pop compares more children per level, which usually fit in one cache line.
+//
+// push() returns a handle that stays valid while the element is in the heap, even as
+// it moves around; decrease_key() and erase() take such a handle. A handle carries a
+// generation, so using it after its element was popped or erased is detected.
+template <typename T, unsigned D = 4, typename Compare = std::less<T>>
+class dAryHeap
+{
+    static_assert(D >= 2, "a heap needs at least two children per node");
+
+public:
+    struct handle{
+        std::uint32_t id;
+        std::uint32_t generation;
+    };
+
+private:
+    static constexpr std::size_t kFree = std::numeric_limits<std::size_t>::max();
+    static constexpr std::uint32_t kNone = 0xffffffffu;
+
+    struct entry{
+        T value;
+        std::uint32_t id;
+    };
+
+    // where an id currently lives in data, or the next free id when unused
+    struct slot{
+        std::size_t pos;
+        std::uint32_t generation;
+        std::uint32_t nextFree;
+    };
+
+    entry* data;
+    std::size_t cap;
+    std::size_t count;
+    std::vector<slot> slots;
+    std::uint32_t freeList;
+    Compare cmp;
+    double growth = 2.0;
+
+    void resize(std::size_t newCap){
+        if(newCap <= cap){
+            return;
+        }
+        entry* newData = new entry[newCap];
+        try
+        {
+            for(std::size_t i = 0; i < count; i++){
+                newData[i] = std::move_if_noexcept(data[i]);
+            }
+        }
+        catch(...)
+        {
+            delete [] newData;
+            throw;
+        }
+
+        delete [] data;
+        data = newData;
+        cap = newCap;
+    }
+
+    void ensureCapacity(){
+        if(count >= cap){
+            std::size_t newCap = calculateNewCap();
+            if(newCap <= cap){
+                throw std::length_error("dAryHeap: capacity overflow");
+            }
+            resize(newCap);
+        }
+    }
+
+    std::size_t calculateNewCap(){
+        if(cap == 0){
+            return 1;
+        }
+
+        std::size_t maxCap = std::numeric_limits<size_t>::max() / sizeof(entry);
+        if(cap > maxCap / growth){
+            return maxCap;
+        }
+        return static_cast<std::size_t>(cap * growth);
+    }
+
+    std::uint32_t allocId(){
+        if(freeList != kNone){
+            std::uint32_t id = freeList;
+            freeList = slots[id].nextFree;
+            return id;
+        }
+        if(slots.size() >= kNone){
+            throw std::length_error("dAryHeap: too many elements");
+        }
+        slots.push_back(slot{kFree, 0, kNone});
+        return static_cast<std::uint32_t>(slots.size() - 1);
+    }
+
+    void freeId(std::uint32_t id){
+        slots[id].pos = kFree;
+        slots[id].generation++;
+        slots[id].nextFree = freeList;
+        freeList = id;
+    }
+
+    void place(std::size_t i, entry&& e){
+        data[i] = std::move(e);
+        slots[data[i].id].pos = i;
+    }
+
+    // hole-based sifts: one move per level instead of a swap
+    void siftUp(std::size_t i){
+        entry e = std::move(data[i]);
+        while(i > 0){
+            std::size_t parent = (i - 1) / D;
+            if(!cmp(e.value, data[parent].value)){
+                break;
+            }
+            place(i, std::move(data[parent]));
+            i = parent;
+        }
+        place(i, std::move(e));
+    }
+
+    void siftDown(std::size_t i){
+        entry e = std::move(data[i]);
+        for(;;){
+            std::size_t first = D * i + 1;
+            if(first >= count){
+                break;
+            }
+            std::size_t last = first + D < count ? first + D : count;
+            std::size_t best = first;
+            for(std::size_t c = first + 1; c < last; c++){
+                if(cmp(data[c].value, data[best].value)){
+                    best = c;
+                }
+            }
+            if(!cmp(data[best].value, e.value)){
+                break;
+            }
+            place(i, std::move(data[best]));
+            i = best;
+        }
+        place(i, std::move(e));
+    }
+
+    bool valid(handle h) const{
+        return h.id < slots.size() && slots[h.id].generation == h.generation && slots[h.id].pos != kFree;
+    }
+
+    void removeAt(std::size_t i){
+        freeId(data[i].id);
+        count--;
+        if(i == count){
+            return;
+        }
+        place(i, std::move(data[count]));
+        if(i > 0 && cmp(data[i].value, data[(i - 1) / D].value)){
+            siftUp(i);
+        }
+        else{
+            siftDown(i);
+        }
+    }
+
+    // append at the end without restoring the heap order
+    template <typename U>
+    handle append(U&& value){
+        ensureCapacity();
+        std::uint32_t id = allocId();
+        data[count].value = std::forward<U>(value);
+        data[count].id = id;
+        slots[id].pos = count;
+        count++;
+        return handle{id, slots[id].generation};
+    }
+
+    // Floyd's bottom-up heapify, O(size)
+    void heapify(){
+        if(count < 2){
+            return;
+        }
+        for(std::size_t i = (count - 2) / D + 1; i-- > 0;){
+            siftDown(i);
+        }
+    }
+
+public:
+    // ctor
+    explicit dAryHeap(std::size_t cap = 16, Compare cmp = Compare())
+        : data(new entry[cap]), cap(cap), count(0), freeList(kNone), cmp(cmp){}
+
+    // copy ctor
+    dAryHeap(const dAryHeap& other)
+        : data(new entry[other.cap]), cap(other.cap), count(other.count), slots(other.slots),
+          freeList(other.freeList), cmp(other.cmp), growth(other.growth){
+        for(std::size_t i = 0; i < count; i++){
+            data[i] = other.data[i];
+        }
+    }
+
+    // move ctor
+    dAryHeap(dAryHeap&& other) noexcept
+        : data(std::exchange(other.data, nullptr)),
+          cap(std::exchange(other.cap, 0)),
+          count(std::exchange(other.count, 0)),
+          slots(std::move(other.slots)),
+          freeList(std::exchange(other.freeList, kNone)),
+          cmp(other.cmp),
+          growth(other.growth){}
+
+    // copy & move assignment
+    dAryHeap& operator=(dAryHeap other) noexcept{
+        swap(other);
+        return *this;
+    }
+
+    // destructor
+    ~dAryHeap() noexcept{
+        delete [] data;
+    }
+
+    void swap(dAryHeap& other) noexcept{
+        std::swap(data, other.data);
+        std::swap(cap, other.cap);
+        std::swap(count, other.count);
+        slots.swap(other.slots);
+        std::swap(freeList, other.freeList);
+        std::swap(cmp, other.cmp);
+        std::swap(growth, other.growth);
+    }
+
+    handle push(const T& value){
+        handle h = append(value);
+        siftUp(count - 1);
+        return h;
+    }
+
+    handle push(T&& value){
+        handle h = append(std::move(value));
+        siftUp(count - 1);
+        return h;
+    }
+
+    // add [first, last) and restore the heap in O(size) instead of O(n log size)
+    template <typename InputIt>
+    void buildHeap(InputIt first, InputIt last){
+        for(; first != last; ++first){
+            append(*first);
+        }
+        heapify();
+    }
+
+    // same, writing the handle of every added element to handlesOut
+    template <typename InputIt, typename OutputIt>
+    OutputIt buildHeap(InputIt first, InputIt last, OutputIt handlesOut){
+        for(; first != last; ++first){
+            *handlesOut++ = append(*first);
+        }
+        heapify();
+        return handlesOut;
+    }
+
+    const T& top() const{
+        if(count == 0){
+            throw std::runtime_error("Heap is empty");
+        }
+        return data[0].value;
+    }
+
+    void pop(){
+        if(count == 0){
+            throw std::underflow_error("Heap is empty");
+        }
+        removeAt(0);
+    }
+
+    // pop, moving the top into out instead of copying it out through top() first
+    void pop(T& out){
+        if(count == 0){
+            throw std::underflow_error("Heap is empty");
+        }
+        out = std::move(data[0].value);
+        removeAt(0);
+    }
+
+    // move the element to a value that compares less or equal (higher priority)
+    void decrease_key(handle h, const T& value){
+        if(!valid(h)){
+            throw std::invalid_argument("dAryHeap: stale handle");
+        }
+        std::size_t i = slots[h.id].pos;
+        if(cmp(data[i].value, value)){
+            throw std::invalid_argument("dAryHeap: decrease_key to a larger key");
+        }
+        data[i].value = value;
+        siftUp(i);
+    }
+
+    // false if the element was already popped or erased
+    bool erase(handle h){
+        if(!valid(h)){
+            return false;
+        }
+        removeAt(slots[h.id].pos);
+        return true;
+    }
+
+    bool contains(handle h) const{
+        return valid(h);
+    }
+
+    const T& get(handle h) const{
+        if(!valid(h)){
+            throw std::invalid_argument("dAryHeap: stale handle");
+        }
+        return data[slots[h.id].pos].value;
+    }
+
+    // visit every element in storage (not priority) order
+    template <typename Fn>
+    void forEach(Fn fn) const{
+        for(std::size_t i = 0; i < count; i++){
+            fn(data[i].value);
+        }
+    }
+
+    bool empty() const{
+        return count == 0;
+    }
+
+    std::size_t size() const{
+        return count;
+    }
+
+    std::size_t capacity() const{
+        return cap;
+    }
+
+    // invalidates every handle
+    void clear(){
+        for(std::size_t i = 0; i < count; i++){
+            freeId(data[i].id);
+        }
+        count = 0;
+    }
+};
@@ -0,0 +1,301 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <chrono>
+#include <queue>
+#include <random>
+#include <algorithm>
+#include <iterator>
+#include <set>
+#include <functional>
+#include <cstdint>
+
+// 包含你的d-ary heap實現
+#include "dAryHeap.cpp"
+
+// 測試計數器
+int tests_passed = 0;
+int tests_total = 0;
+
+// 測試輔助宏
+#define TEST(name) \
+    void test_##name(); \
+    void run_test_##name() { \
+        tests_total++; \
+        std::cout << "Testing " #name "... "; \
+        try { \
+            test_##name(); \
+            tests_passed++; \
+            std::cout << "PASSED\n"; \
+        } catch (const std::exception& e) { \
+            std::cout << "FAILED: " << e.what() << "\n"; \
+        } catch (...) { \
+            std::cout << "FAILED: Unknown exception\n"; \
+        } \
+    } \
+    void test_##name()
+
+// 輔助函數：把heap全部pop出來
+template <typename Heap>
+auto drain(Heap& h) {
+    std::vector<typename std::decay<decltype(h.top())>::type> out;
+    while (!h.empty()) {
+        out.push_back(h.top());
+        h.pop();
+    }
+    return out;
+}
+
+// ============= 基本功能測試 =============
+
+TEST(push_pop_order) {
+    dAryHeap<int, 2> h(1);  // 從容量1開始擴容
+    for (int v : {5, 3, 8, 1, 9, 2, 7}) h.push(v);
+    assert(h.size() == 7);
+    assert(h.capacity() >= 7);
+    assert(h.top() == 1);
+    assert((drain(h) == std::vector<int>{1, 2, 3, 5, 7, 8, 9}));
+    assert(h.empty());
+
+    try {
+        h.pop();
+        assert(false);
+    } catch (const std::underflow_error&) {
+        // 預期的異常
+    }
+    try {
+        h.top();
+        assert(false);
+    } catch (const std::runtime_error&) {
+        // 預期的異常
+    }
+}
+
+TEST(max_heap_and_strings) {
+    dAryHeap<std::string, 3, std::greater<std::string>> h;
+    for (const char* s : {"pear", "apple", "zebra", "mango"}) h.push(s);
+    assert(h.top() == "zebra");
+    assert((drain(h) == std::vector<std::string>{"zebra", "pear", "mango", "apple"}));
+
+    h.push("kiwi");
+    h.push("fig");
+    std::string out;
+    h.pop(out);  // 直接把top move出來
+    assert(out == "kiwi" && h.size() == 1 && h.top() == "fig");
+    h.pop(out);
+    assert(out == "fig" && h.empty());
+    try {
+        h.pop(out);
+        assert(false);
+    } catch (const std::underflow_error&) {
+        // 預期的異常
+    }
+}
+
+TEST(build_heap) {
+    std::mt19937 rng(2);
+    std::vector<int> values(10000);
+    for (auto& v : values) v = static_cast<int>(rng() % 100000);
+
+    dAryHeap<int, 4> h(0);
+    h.push(-1);
+    std::vector<dAryHeap<int, 4>::handle> handles;
+    h.buildHeap(values.begin(), values.end(), std::back_inserter(handles));
+    assert(h.size() == values.size() + 1);
+    assert(handles.size() == values.size());
+    for (std::size_t i = 0; i < values.size(); i += 997) assert(h.get(handles[i]) == values[i]);
+
+    std::vector<int> expected = values;
+    expected.push_back(-1);
+    std::sort(expected.begin(), expected.end());
+    assert(drain(h) == expected);
+}
+
+TEST(decrease_key_and_erase) {
+    dAryHeap<int, 4> h;
+    auto a = h.push(50);
+    auto b = h.push(40);
+    auto c = h.push(30);
+    auto d = h.push(20);
+
+    h.decrease_key(a, 10);  // 50 -> 10，變成top
+    assert(h.top() == 10);
+    assert(h.get(a) == 10);
+    try {
+        h.decrease_key(b, 45);  // 不能變大
+        assert(false);
+    } catch (const std::invalid_argument&) {
+        // 預期的異常
+    }
+
+    assert(h.erase(c));
+    assert(!h.erase(c));  // 重複erase
+    assert(!h.contains(c));
+    assert((drain(h) == std::vector<int>{10, 20, 40}));
+    assert(!h.contains(a) && !h.contains(b) && !h.contains(d));
+
+    // id被重用後，舊handle仍然無效
+    auto e = h.push(7);
+    assert(e.id == a.id || e.id == b.id || e.id == c.id || e.id == d.id);
+    assert(!h.erase(a) && !h.erase(b) && !h.erase(c) && !h.erase(d));
+    try {
+        h.decrease_key(a, 1);
+        assert(false);
+    } catch (const std::invalid_argument&) {
+        // 預期的異常
+    }
+    assert(h.get(e) == 7);
+}
+
+TEST(random_against_multiset) {
+    std::mt19937 rng(7);
+    dAryHeap<int, 8> h;
+    std::vector<std::pair<dAryHeap<int, 8>::handle, int>> live;
+    std::multiset<int> ref;
+    for (int step = 0; step < 200000; step++) {
+        int op = rng() % 10;
+        if (op < 4 || ref.empty()) {
+            int v = static_cast<int>(rng() % 1000000);
+            live.push_back({h.push(v), v});
+            ref.insert(v);
+        } else if (op < 6) {
+            assert(h.top() == *ref.begin());
+            ref.erase(ref.begin());
+            h.pop();
+        } else if (op < 8) {
+            std::size_t i = rng() % live.size();
+            if (h.contains(live[i].first)) {
+                int nv = live[i].second - static_cast<int>(rng() % 1000);
+                ref.erase(ref.find(live[i].second));
+                ref.insert(nv);
+                h.decrease_key(live[i].first, nv);
+                live[i].second = nv;
+            }
+        } else {
+            std::size_t i = rng() % live.size();
+            if (h.erase(live[i].first)) ref.erase(ref.find(live[i].second));
+            live[i] = live.back();
+            live.pop_back();
+        }
+        assert(h.size() == ref.size());
+    }
+    std::vector<int> expected(ref.begin(), ref.end());
+    assert(drain(h) == expected);
+}
+
+TEST(copy_and_move) {
+    dAryHeap<int> h;
+    auto a = h.push(3);
+    h.push(1);
+    h.push(2);
+
+    dAryHeap<int> copy(h);
+    copy.decrease_key(a, 0);  // 副本的handle表也被複製
+    assert(copy.top() == 0);
+    assert(h.top() == 1);
+
+    dAryHeap<int> moved(std::move(copy));
+    assert(moved.size() == 3 && moved.top() == 0);
+
+    h = moved;
+    assert((drain(h) == std::vector<int>{0, 1, 2}));
+    assert(moved.size() == 3);
+}
+
+// ============= 性能測試 =============
+
+template <unsigned D>
+static long long runHeap(const std::vector<std::uint32_t>& keys, double& ms) {
+    auto t0 = std::chrono::steady_clock::now();
+    dAryHeap<std::uint32_t, D> h;
+    long long sum = 0;
+    for (std::size_t i = 0; i < keys.size(); i++) {
+        h.push(keys[i]);
+        if (i % 3 == 2) {  // 混合push/pop，最後全部pop
+            sum += h.top();
+            h.pop();
+        }
+    }
+    while (!h.empty()) {
+        sum += h.top();
+        h.pop();
+    }
+    ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    return sum;
+}
+
+TEST(arity_vs_priority_queue) {
+    const std::size_t N = 3000000;
+    std::mt19937 rng(13);
+    std::vector<std::uint32_t> keys(N);
+    for (auto& k : keys) k = rng();
+
+    double ms2, ms4, ms8, msStd;
+    long long s2 = runHeap<2>(keys, ms2);
+    long long s4 = runHeap<4>(keys, ms4);
+    long long s8 = runHeap<8>(keys, ms8);
+
+    auto t0 = std::chrono::steady_clock::now();
+    long long sStd = 0;
+    {
+        std::priority_queue<std::uint32_t, std::vector<std::uint32_t>, std::greater<std::uint32_t>> pq;
+        for (std::size_t i = 0; i < N; i++) {
+            pq.push(keys[i]);
+            if (i % 3 == 2) {
+                sStd += pq.top();
+                pq.pop();
+            }
+        }
+        while (!pq.empty()) {
+            sStd += pq.top();
+            pq.pop();
+        }
+    }
+    msStd = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    assert(s2 == sStd && s4 == sStd && s8 == sStd);
+
+    // buildHeap vs 逐一push
+    auto t1 = std::chrono::steady_clock::now();
+    dAryHeap<std::uint32_t, 4> built;
+    built.buildHeap(keys.begin(), keys.end());
+    auto t2 = std::chrono::steady_clock::now();
+    dAryHeap<std::uint32_t, 4> pushed;
+    for (auto k : keys) pushed.push(k);
+    auto t3 = std::chrono::steady_clock::now();
+    assert(built.top() == pushed.top());
+
+    std::cout << "\n  " << N << " push + pop: d=2 " << ms2 << "ms, d=4 " << ms4 << "ms, d=8 " << ms8
+              << "ms, std::priority_queue " << msStd << "ms"
+              << "\n  buildHeap " << std::chrono::duration<double, std::milli>(t2 - t1).count()
+              << "ms vs push one by one " << std::chrono::duration<double, std::milli>(t3 - t2).count() << "ms ";
+}
+
+// ============= 主測試函數 =============
+
+int main() {
+    std::cout << "=== DAryHeap 測試套件 ===\n\n";
+
+    // 運行所有測試
+    run_test_push_pop_order();
+    run_test_max_heap_and_strings();
+    run_test_build_heap();
+    run_test_decrease_key_and_erase();
+    run_test_random_against_multiset();
+    run_test_copy_and_move();
+    run_test_arity_vs_priority_queue();
+
+    // 測試結果
+    std::cout << "\n=== 測試結果 ===\n";
+    std::cout << "通過: " << tests_passed << "/" << tests_total << " 測試\n";
+
+    if (tests_passed == tests_total) {
+        std::cout << "🎉 所有測試通過！\n";
+        return 0;
+    } else {
+        std::cout << "❌ 有 " << (tests_total - tests_passed) << " 個測試失敗\n";
+        return 1;
+    }
+}
@@ -0,0 +1,225 @@
+#include <iostream>
+#include <utility>
+#include <stdexcept>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <thread>
+#include <limits>
+#include <functional>
+#include <cstdint>
+
+#include "dAryHeap.cpp"
+
+// Relaxed concurrent priority queue (MultiQueue): c * threads sequential dAryHeaps,
+// each behind a try-lock. push() locks a random heap; tryPop() looks at the cached top
+// keys of two random heaps, locks the better one and pops from it. Nobody ever waits
+// on a lock -- a busy heap is simply skipped -- so threads scale, at the price of a
+// rank error: the popped key is the smallest of its heap, not necessarily overall.
+// A larger c means less contention and a larger expected rank error.
+//
+// With rankSampleEvery = k > 0, every k-th pop of this queue counts how many queued
+// keys were smaller than the one it returned; see rankErrors().
+template <typename Value, typename Key = std::uint64_t>
+class multiQueue
+{
+public:
+    struct rankStats{
+        std::uint64_t samples;
+        double mean;
+        std::uint64_t max;
+        std::uint64_t histogram[16];    // bucket 0: exact, bucket b: rank in [2^(b-1), 2^b),
+                                        // the last bucket is open-ended
+    };
+
+private:
+    struct entry{
+        Key key;
+        Value value;
+    };
+
+    struct byKey{
+        bool operator()(const entry& a, const entry& b) const{
+            return a.key < b.key;
+        }
+    };
+
+    struct alignas(64) shard{
+        std::atomic<bool> locked{false};
+        std::atomic<Key> topKey{std::numeric_limits<Key>::max()};
+        std::atomic<std::size_t> count{0};
+        dAryHeap<entry, 4, byKey> heap;
+
+        bool tryLock(){
+            return !locked.load(std::memory_order_relaxed) &&
+                   !locked.exchange(true, std::memory_order_acquire);
+        }
+
+        void lock(){
+            while(!tryLock()){
+                std::this_thread::yield();
+            }
+        }
+
+        // republish the cached top before releasing the heap
+        void unlock(){
+            std::size_t n = heap.size();
+            count.store(n, std::memory_order_relaxed);
+            topKey.store(n > 0 ? heap.top().key : std::numeric_limits<Key>::max(),
+                         std::memory_order_relaxed);
+            locked.store(false, std::memory_order_release);
+        }
+    };
+
+    std::vector<std::unique_ptr<shard>> shards;
+    std::size_t rankSampleEvery;
+    std::atomic<std::uint64_t> pops{0};
+    std::atomic<std::uint64_t> rankSamples{0};
+    std::atomic<std::uint64_t> rankSum{0};
+    std::atomic<std::uint64_t> rankMax{0};
+    std::atomic<std::uint64_t> rankHistogram[16];
+
+    static std::uint64_t nextRandom(){
+        static thread_local std::uint64_t s = 0x9e3779b97f4a7c15ULL ^
+            std::hash<std::thread::id>()(std::this_thread::get_id());
+        s ^= s << 13;
+        s ^= s >> 7;
+        s ^= s << 17;
+        return s;
+    }
+
+    bool allEmpty() const{
+        for(const auto& s : shards){
+            if(s->count.load(std::memory_order_relaxed) != 0){
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // rank of key among what is queued right now; each heap is locked in turn, never
+    // two at once, so the count is only approximate under concurrent updates
+    void sampleRank(Key key){
+        std::uint64_t rank = 0;
+        for(auto& s : shards){
+            s->lock();
+            s->heap.forEach([&](const entry& e){
+                if(e.key < key){
+                    rank++;
+                }
+            });
+            s->unlock();
+        }
+        rankSamples.fetch_add(1, std::memory_order_relaxed);
+        rankSum.fetch_add(rank, std::memory_order_relaxed);
+        std::uint64_t m = rankMax.load(std::memory_order_relaxed);
+        while(rank > m && !rankMax.compare_exchange_weak(m, rank, std::memory_order_relaxed)){
+        }
+        unsigned b = 0;
+        while(b < 15 && (std::uint64_t(1) << b) <= rank){
+            b++;
+        }
+        rankHistogram[b].fetch_add(1, std::memory_order_relaxed);
+    }
+
+public:
+    // ctor: c heaps per thread
+    explicit multiQueue(std::size_t threads, std::size_t c = 2, std::size_t rankSampleEvery = 0)
+        : rankSampleEvery(rankSampleEvery){
+        std::size_t n = threads * c;
+        if(n == 0){
+            throw std::invalid_argument("multiQueue needs at least one heap");
+        }
+        for(std::size_t i = 0; i < n; i++){
+            shards.emplace_back(new shard);
+        }
+        for(auto& h : rankHistogram){
+            h.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    multiQueue(const multiQueue&) = delete;
+    multiQueue& operator=(const multiQueue&) = delete;
+
+    void push(Key key, const Value& value){
+        std::size_t n = shards.size();
+        for(;;){
+            shard& s = *shards[nextRandom() % n];
+            if(s.tryLock()){
+                s.heap.push(entry{key, value});
+                s.unlock();
+                return;
+            }
+        }
+    }
+
+    // false once every heap was seen empty
+    bool tryPop(Key& key, Value& value){
+        std::size_t n = shards.size();
+        for(;;){
+            std::size_t i = nextRandom() % n;
+            std::size_t j = n > 1 ? nextRandom() % n : i;
+            shard* a = shards[i].get();
+            shard* b = shards[j].get();
+            bool aHas = a->count.load(std::memory_order_relaxed) != 0;
+            bool bHas = b->count.load(std::memory_order_relaxed) != 0;
+            if(!aHas && !bHas){
+                if(allEmpty()){
+                    return false;
+                }
+                continue;
+            }
+            shard* best = a;
+            if(!aHas || (bHas && b->topKey.load(std::memory_order_relaxed) <
+                                 a->topKey.load(std::memory_order_relaxed))){
+                best = b;
+            }
+            if(!best->tryLock()){
+                continue;
+            }
+            if(best->heap.empty()){
+                best->unlock();
+                continue;
+            }
+            entry top;
+            best->heap.pop(top);
+            best->unlock();
+            key = std::move(top.key);
+            value = std::move(top.value);
+
+            if(rankSampleEvery != 0 &&
+               (pops.fetch_add(1, std::memory_order_relaxed) + 1) % rankSampleEvery == 0){
+                sampleRank(key);
+            }
+            return true;
+        }
+    }
+
+    // snapshot, may be stale by the time it returns
+    std::size_t size() const{
+        std::size_t n = 0;
+        for(const auto& s : shards){
+            n += s->count.load(std::memory_order_relaxed);
+        }
+        return n;
+    }
+
+    bool empty() const{
+        return allEmpty();
+    }
+
+    std::size_t heapCount() const{
+        return shards.size();
+    }
+
+    rankStats rankErrors() const{
+        rankStats r;
+        r.samples = rankSamples.load(std::memory_order_relaxed);
+        r.mean = r.samples ? double(rankSum.load(std::memory_order_relaxed)) / double(r.samples) : 0.0;
+        r.max = rankMax.load(std::memory_order_relaxed);
+        for(int b = 0; b < 16; b++){
+            r.histogram[b] = rankHistogram[b].load(std::memory_order_relaxed);
+        }
+        return r;
+    }
+};
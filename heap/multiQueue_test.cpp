@@ -0,0 +1,230 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <random>
+#include <cstdint>
+
+// 包含你的MultiQueue實現
+#include "multiQueue.cpp"
+
+// 測試計數器
+int tests_passed = 0;
+int tests_total = 0;
+
+// 測試輔助宏
+#define TEST(name) \
+    void test_##name(); \
+    void run_test_##name() { \
+        tests_total++; \
+        std::cout << "Testing " #name "... "; \
+        try { \
+            test_##name(); \
+            tests_passed++; \
+            std::cout << "PASSED\n"; \
+        } catch (const std::exception& e) { \
+            std::cout << "FAILED: " << e.what() << "\n"; \
+        } catch (...) { \
+            std::cout << "FAILED: Unknown exception\n"; \
+        } \
+    } \
+    void test_##name()
+
+// ============= 基本功能測試 =============
+
+TEST(single_heap_is_exact) {
+    multiQueue<std::string> q(1, 1);  // 只有一個heap時就是普通的priority queue
+    assert(q.heapCount() == 1);
+    q.push(30, "c");
+    q.push(10, "a");
+    q.push(20, "b");
+    assert(q.size() == 3);
+
+    std::uint64_t k;
+    std::string v;
+    assert(q.tryPop(k, v) && k == 10 && v == "a");
+    assert(q.tryPop(k, v) && k == 20 && v == "b");
+    assert(q.tryPop(k, v) && k == 30 && v == "c");
+    assert(!q.tryPop(k, v));
+    assert(q.empty());
+
+    try {
+        multiQueue<int> bad(0);
+        assert(false);
+    } catch (const std::invalid_argument&) {
+        // 預期的異常
+    }
+}
+
+TEST(relaxed_order_but_nothing_lost) {
+    multiQueue<int> q(4, 2, 1);  // 8個heap，每次pop都取樣rank error
+    const int N = 2000;
+    for (int i = 0; i < N; i++) q.push(static_cast<std::uint64_t>(i), i);
+
+    std::vector<int> seen(N, 0);
+    std::uint64_t k;
+    int v;
+    int popped = 0;
+    while (q.tryPop(k, v)) {
+        assert(static_cast<int>(k) == v);
+        seen[v]++;
+        popped++;
+    }
+    assert(popped == N);
+    for (int s : seen) assert(s == 1);
+
+    auto stats = q.rankErrors();
+    assert(stats.samples == std::uint64_t(N));
+    std::uint64_t total = 0;
+    for (auto h : stats.histogram) total += h;
+    assert(total == stats.samples);
+    assert(stats.mean > 0 && stats.mean < 100);  // 有誤差，但只有heap數量級
+    assert(stats.max >= 1);
+}
+
+TEST(rank_sampling_is_per_queue) {
+    multiQueue<int> a(1, 1, 2), b(1, 1, 2);  // 同一個thread交替pop兩個queue
+    const int N = 10;
+    for (int i = 0; i < N; i++) {
+        a.push(static_cast<std::uint64_t>(i), i);
+        b.push(static_cast<std::uint64_t>(i), i);
+    }
+    std::uint64_t k;
+    int v;
+    for (int i = 0; i < N; i++) {
+        assert(a.tryPop(k, v) && v == i);
+        assert(b.tryPop(k, v) && v == i);
+    }
+    // 各自每2次pop取樣一次，不會因為共用計數器而全落在同一個queue
+    assert(a.rankErrors().samples == N / 2);
+    assert(b.rankErrors().samples == N / 2);
+}
+
+TEST(concurrent_push_pop) {
+    const int THREADS = 4, PER = 50000;
+    multiQueue<std::uint64_t> q(THREADS, 2);
+    std::atomic<std::uint64_t> sumPopped{0};
+    std::atomic<int> popped{0};
+
+    std::vector<std::thread> ts;
+    for (int t = 0; t < THREADS; t++) {
+        ts.emplace_back([&, t] {
+            std::mt19937_64 rng(t);
+            std::uint64_t k, v;
+            for (int i = 0; i < PER; i++) {
+                std::uint64_t x = std::uint64_t(t) * PER + i;
+                q.push(rng() % 1000000, x);
+                if (i % 2 == 1 && q.tryPop(k, v)) {
+                    sumPopped.fetch_add(v);
+                    popped.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto& th : ts) th.join();
+
+    std::uint64_t k, v;
+    while (q.tryPop(k, v)) {
+        sumPopped.fetch_add(v);
+        popped.fetch_add(1);
+    }
+    const std::uint64_t n = std::uint64_t(THREADS) * PER;
+    assert(popped.load() == int(n));
+    assert(sumPopped.load() == n * (n - 1) / 2);
+}
+
+// ============= 性能測試 =============
+
+// 每個thread交替push/pop，回傳每秒操作數(百萬)
+template <typename Push, typename Pop>
+static double throughput(int threads, int opsPerThread, Push push, Pop pop) {
+    std::atomic<bool> go{false};
+    std::vector<std::thread> ts;
+    for (int t = 0; t < threads; t++) {
+        ts.emplace_back([&, t] {
+            std::mt19937_64 rng(t + 100);
+            while (!go.load()) std::this_thread::yield();
+            for (int i = 0; i < opsPerThread; i++) {
+                if (i % 2 == 0) push(rng() % (1ULL << 32));
+                else pop();
+            }
+        });
+    }
+    auto t0 = std::chrono::steady_clock::now();
+    go.store(true);
+    for (auto& th : ts) th.join();
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return threads * double(opsPerThread) / s / 1e6;
+}
+
+TEST(scaling_and_rank_error) {
+    const int PREFILL = 1000000, OPS = 1000000;
+    std::cout << "\n  (" << std::thread::hardware_concurrency() << " hardware threads)";
+
+    for (int threads : {1, 2, 4, 8}) {
+        multiQueue<std::uint32_t> mq(threads, 2);
+        std::mt19937_64 rng(1);
+        for (int i = 0; i < PREFILL; i++) mq.push(rng() % (1ULL << 32), 0);
+        double mqRate = throughput(threads, OPS / threads,
+            [&](std::uint64_t k) { mq.push(k, 0); },
+            [&] { std::uint64_t k; std::uint32_t v; mq.tryPop(k, v); });
+
+        // 基準：一個mutex保護的heap
+        dAryHeap<std::uint64_t, 4> heap;
+        std::mutex mtx;
+        for (int i = 0; i < PREFILL; i++) heap.push(rng() % (1ULL << 32));
+        double lockedRate = throughput(threads, OPS / threads,
+            [&](std::uint64_t k) { std::lock_guard<std::mutex> lock(mtx); heap.push(k); },
+            [&] { std::lock_guard<std::mutex> lock(mtx); if (!heap.empty()) heap.pop(); });
+
+        std::cout << "\n  " << threads << " threads: multiQueue(c=2) " << mqRate << " Mops/s, locked heap "
+                  << lockedRate << " Mops/s";
+    }
+
+    // 品質與吞吐量的取捨：c越大，rank error越大
+    for (int c : {1, 2, 4, 8}) {
+        const int THREADS = 4;
+        multiQueue<std::uint32_t> mq(THREADS, c, 8);
+        std::mt19937_64 rng(2);
+        for (int i = 0; i < 10000; i++) mq.push(rng() % (1ULL << 32), 0);
+        double rate = throughput(THREADS, 50000,
+            [&](std::uint64_t k) { mq.push(k, 0); },
+            [&] { std::uint64_t k; std::uint32_t v; mq.tryPop(k, v); });
+        auto st = mq.rankErrors();
+        std::cout << "\n  c=" << c << " (" << mq.heapCount() << " heaps): rank error mean " << st.mean
+                  << ", max " << st.max << " over " << st.samples << " samples (" << rate
+                  << " Mops/s incl. sampling)";
+    }
+    std::cout << " ";
+}
+
+// ============= 主測試函數 =============
+
+int main() {
+    std::cout << "=== MultiQueue 測試套件 ===\n\n";
+
+    // 運行所有測試
+    run_test_single_heap_is_exact();
+    run_test_relaxed_order_but_nothing_lost();
+    run_test_rank_sampling_is_per_queue();
+    run_test_concurrent_push_pop();
+    run_test_scaling_and_rank_error();
+
+    // 測試結果
+    std::cout << "\n=== 測試結果 ===\n";
+    std::cout << "通過: " << tests_passed << "/" << tests_total << " 測試\n";
+
+    if (tests_passed == tests_total) {
+        std::cout << "🎉 所有測試通過！\n";
+        return 0;
+    } else {
+        std::cout << "❌ 有 " << (tests_total - tests_passed) << " 個測試失敗\n";
+        return 1;
+    }
+}
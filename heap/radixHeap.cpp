@@ -0,0 +1,160 @@
+#include <iostream>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+#include <limits>
+#include <vector>
+#include <cstdint>
+
+// Monotone priority queue for unsigned integer keys: a pushed key may never be smaller
+// than the last popped one (Dijkstra, discrete-event simulation). Bucket 0 holds keys
+// equal to the last popped key, bucket b the keys whose highest bit differing from it
+// is bit b-1. When bucket 0 runs dry, the first non-empty bucket is scanned for its
+// minimum, which becomes the new reference, and its elements are redistributed into
+// strictly lower buckets. Every element only ever moves down, so push and pop are
+// amortized O(log C) with no key comparisons between elements.
+template <typename Value, typename Key = std::uint64_t>
+class radixHeap
+{
+    static_assert(std::is_unsigned<Key>::value, "radixHeap needs an unsigned key type");
+
+public:
+    typedef std::pair<Key, Value> element;
+
+private:
+    static constexpr unsigned kBits = std::numeric_limits<Key>::digits;
+
+    std::vector<element> buckets[kBits + 1];
+    Key last;
+    std::size_t count;
+    // while bucket 0 is empty: where the minimum sits, 0 if not located yet
+    mutable unsigned minBucket = 0;
+    mutable std::size_t minIdx = 0;
+
+    static unsigned bucketOf(Key key, Key ref){
+        Key x = key ^ ref;
+        if(x == 0){
+            return 0;
+        }
+        return kBits - static_cast<unsigned>(__builtin_clzll(static_cast<unsigned long long>(x)) -
+                                             (std::numeric_limits<unsigned long long>::digits - kBits));
+    }
+
+    // find the smallest key of the first non-empty bucket above bucket 0; the result is
+    // kept until pull() redistributes that bucket, and push() keeps it up to date, so
+    // top() followed by pop() scans the bucket once
+    void locateMin() const{
+        if(minBucket != 0){
+            return;
+        }
+        unsigned b = 1;
+        while(buckets[b].empty()){
+            b++;
+        }
+        const std::vector<element>& from = buckets[b];
+        std::size_t m = 0;
+        for(std::size_t i = 1; i < from.size(); i++){
+            if(from[i].first < from[m].first){
+                m = i;
+            }
+        }
+        minBucket = b;
+        minIdx = m;
+    }
+
+    // the element just appended to bucket b may be the new minimum
+    void pushed(unsigned b){
+        if(minBucket == 0 || b == 0){
+            return;
+        }
+        // buckets below minBucket are empty, so a lower b holds only the new element
+        if(b < minBucket || buckets[b].back().first < buckets[minBucket][minIdx].first){
+            minBucket = b;
+            minIdx = buckets[b].size() - 1;
+        }
+    }
+
+    // make bucket 0 non-empty
+    void pull(){
+        if(!buckets[0].empty()){
+            return;
+        }
+        locateMin();
+        std::vector<element>& from = buckets[minBucket];
+        last = from[minIdx].first;
+        minBucket = 0;
+        for(element& e : from){
+            buckets[bucketOf(e.first, last)].push_back(std::move(e));
+        }
+        from.clear();
+    }
+
+public:
+    // ctor, start is the smallest key that may be pushed
+    explicit radixHeap(Key start = 0) : last(start), count(0){}
+
+    void push(Key key, const Value& value){
+        if(key < last){
+            throw std::invalid_argument("radixHeap: key below the last popped key");
+        }
+        unsigned b = bucketOf(key, last);
+        buckets[b].emplace_back(key, value);
+        pushed(b);
+        count++;
+    }
+
+    void push(Key key, Value&& value){
+        if(key < last){
+            throw std::invalid_argument("radixHeap: key below the last popped key");
+        }
+        unsigned b = bucketOf(key, last);
+        buckets[b].emplace_back(key, std::move(value));
+        pushed(b);
+        count++;
+    }
+
+    // leaves lastKey() alone, so keys between the last popped one and top() can still be
+    // pushed. When bucket 0 is empty the first call scans the next bucket (the scan pop()
+    // needs anyway); repeated calls and the following pop() reuse it, so O(1) amortized
+    const element& top() const{
+        if(count == 0){
+            throw std::runtime_error("Heap is empty");
+        }
+        if(!buckets[0].empty()){
+            return buckets[0].back();
+        }
+        locateMin();
+        return buckets[minBucket][minIdx];
+    }
+
+    void pop(){
+        if(count == 0){
+            throw std::underflow_error("Heap is empty");
+        }
+        pull();
+        buckets[0].pop_back();
+        count--;
+    }
+
+    // the reference key: everything in the heap is >= lastKey()
+    Key lastKey() const{
+        return last;
+    }
+
+    bool empty() const{
+        return count == 0;
+    }
+
+    std::size_t size() const{
+        return count;
+    }
+
+    // keeps the reference key, so later pushes must still be >= lastKey()
+    void clear(){
+        for(auto& b : buckets){
+            b.clear();
+        }
+        count = 0;
+        minBucket = 0;
+    }
+};
@@ -0,0 +1,223 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <chrono>
+#include <queue>
+#include <random>
+#include <set>
+#include <functional>
+#include <cstdint>
+
+// 包含你的radix heap實現，以及作為比較對象的binary heap
+#include "radixHeap.cpp"
+#include "dAryHeap.cpp"
+
+// 測試計數器
+int tests_passed = 0;
+int tests_total = 0;
+
+// 測試輔助宏
+#define TEST(name) \
+    void test_##name(); \
+    void run_test_##name() { \
+        tests_total++; \
+        std::cout << "Testing " #name "... "; \
+        try { \
+            test_##name(); \
+            tests_passed++; \
+            std::cout << "PASSED\n"; \
+        } catch (const std::exception& e) { \
+            std::cout << "FAILED: " << e.what() << "\n"; \
+        } catch (...) { \
+            std::cout << "FAILED: Unknown exception\n"; \
+        } \
+    } \
+    void test_##name()
+
+// ============= 基本功能測試 =============
+
+TEST(pops_in_key_order) {
+    radixHeap<std::string> h;
+    h.push(5, "e");
+    h.push(1, "a");
+    h.push(3, "c");
+    h.push(1, "a2");
+    h.push(1000000, "z");
+    assert(h.size() == 5);
+
+    std::vector<std::uint64_t> keys;
+    while (!h.empty()) {
+        keys.push_back(h.top().first);
+        h.pop();
+    }
+    assert((keys == std::vector<std::uint64_t>{1, 1, 3, 5, 1000000}));
+    assert(h.lastKey() == 1000000);
+
+    try {
+        h.pop();
+        assert(false);
+    } catch (const std::underflow_error&) {
+        // 預期的異常
+    }
+    try {
+        h.top();
+        assert(false);
+    } catch (const std::runtime_error&) {
+        // 預期的異常
+    }
+}
+
+TEST(rejects_keys_below_last_pop) {
+    radixHeap<int> h(100);
+    try {
+        h.push(99, 0);
+        assert(false);
+    } catch (const std::invalid_argument&) {
+        // 預期的異常
+    }
+    h.push(150, 1);
+    h.push(120, 2);
+    assert(h.top().second == 2);
+    h.pop();
+    h.push(120, 3);  // 等於上一個pop出來的key是允許的
+    try {
+        h.push(119, 4);
+        assert(false);
+    } catch (const std::invalid_argument&) {
+        // 預期的異常
+    }
+    assert(h.top().first == 120 && h.top().second == 3);
+
+    // top()不會推進lastKey()，介於上一個pop和目前最小值之間的key仍然可以push
+    radixHeap<int> g;
+    g.push(10, 0);
+    g.pop();
+    g.push(50, 1);
+    assert(g.top().first == 50 && g.lastKey() == 10);
+    g.push(20, 2);
+    assert(g.top().first == 20);
+    g.pop();
+    assert(g.lastKey() == 20 && g.top().first == 50);
+}
+
+TEST(full_64_bit_range) {
+    radixHeap<int> h;
+    const std::uint64_t big = std::numeric_limits<std::uint64_t>::max();
+    h.push(big, 3);
+    h.push(big - 1, 2);
+    h.push(1ULL << 63, 1);
+    h.push(0, 0);
+    for (int expected = 0; expected < 4; expected++) {
+        assert(h.top().second == expected);
+        h.pop();
+    }
+
+    radixHeap<int, std::uint32_t> small;
+    small.push(0xffffffffu, 1);
+    small.push(7, 0);
+    assert(small.top().second == 0);
+    small.pop();
+    assert(small.top().first == 0xffffffffu);
+}
+
+TEST(random_monotone_against_multiset) {
+    std::mt19937_64 rng(21);
+    radixHeap<std::uint64_t> h;
+    std::multiset<std::uint64_t> ref;
+    std::uint64_t last = 0;
+    for (int step = 0; step < 300000; step++) {
+        if (ref.empty() || rng() % 5 < 3) {
+            std::uint64_t k = last + (rng() % 4 == 0 ? rng() % (1ULL << 40) : rng() % 100);
+            h.push(k, k);
+            ref.insert(k);
+            if (step % 3 == 0) assert(h.top().first == *ref.begin());  // top()之後再push，快取的最小值要跟著更新
+        } else {
+            assert(h.top().first == *ref.begin());
+            assert(h.top().second == h.top().first);
+            last = *ref.begin();
+            ref.erase(ref.begin());
+            h.pop();
+        }
+        assert(h.size() == ref.size());
+    }
+}
+
+// ============= 性能測試 =============
+
+// Dijkstra式的工作負載：每pop一個key，就push幾個更大的key
+TEST(monotone_workload_vs_binary_heap) {
+    const int OPS = 4000000;
+    std::mt19937_64 rng(5);
+    std::vector<std::uint64_t> incs(OPS * 3);
+    for (auto& x : incs) x = 1 + rng() % 100000;
+
+    auto run = [&](auto& push, auto& popMin, auto& empty) {
+        std::uint64_t checksum = 0;
+        std::size_t next = 0;
+        for (int i = 0; i < 1000; i++) push(incs[next++]);
+        for (int i = 0; i < OPS && !empty(); i++) {
+            std::uint64_t k = popMin();
+            checksum += k;
+            int fanout = (i % 3 == 0) ? 2 : 1;  // 平均每次pop約1.33個push，heap慢慢變大
+            for (int j = 0; j < fanout && next < incs.size(); j++) push(k + incs[next++]);
+        }
+        return checksum;
+    };
+
+    auto t0 = std::chrono::steady_clock::now();
+    radixHeap<std::uint32_t> rh;
+    auto rPush = [&](std::uint64_t k) { rh.push(k, 0); };
+    auto rPop = [&]() { std::uint64_t k = rh.top().first; rh.pop(); return k; };
+    auto rEmpty = [&]() { return rh.empty(); };
+    std::uint64_t sumRadix = run(rPush, rPop, rEmpty);
+
+    auto t1 = std::chrono::steady_clock::now();
+    dAryHeap<std::uint64_t, 2> bh;
+    auto bPush = [&](std::uint64_t k) { bh.push(k); };
+    auto bPop = [&]() { std::uint64_t k = bh.top(); bh.pop(); return k; };
+    auto bEmpty = [&]() { return bh.empty(); };
+    std::uint64_t sumBinary = run(bPush, bPop, bEmpty);
+
+    auto t2 = std::chrono::steady_clock::now();
+    std::priority_queue<std::uint64_t, std::vector<std::uint64_t>, std::greater<std::uint64_t>> pq;
+    auto pPush = [&](std::uint64_t k) { pq.push(k); };
+    auto pPop = [&]() { std::uint64_t k = pq.top(); pq.pop(); return k; };
+    auto pEmpty = [&]() { return pq.empty(); };
+    std::uint64_t sumStd = run(pPush, pPop, pEmpty);
+    auto t3 = std::chrono::steady_clock::now();
+
+    assert(sumRadix == sumBinary && sumBinary == sumStd);
+    auto ms = [](std::chrono::steady_clock::time_point a, std::chrono::steady_clock::time_point b) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(b - a).count();
+    };
+    std::cout << "\n  " << OPS << " pops (64-bit keys, final size " << rh.size() << "): radix heap " << ms(t0, t1)
+              << "ms, binary dAryHeap " << ms(t1, t2) << "ms, std::priority_queue " << ms(t2, t3) << "ms ";
+}
+
+// ============= 主測試函數 =============
+
+int main() {
+    std::cout << "=== RadixHeap 測試套件 ===\n\n";
+
+    // 運行所有測試
+    run_test_pops_in_key_order();
+    run_test_rejects_keys_below_last_pop();
+    run_test_full_64_bit_range();
+    run_test_random_monotone_against_multiset();
+    run_test_monotone_workload_vs_binary_heap();
+
+    // 測試結果
+    std::cout << "\n=== 測試結果 ===\n";
+    std::cout << "通過: " << tests_passed << "/" << tests_total << " 測試\n";
+
+    if (tests_passed == tests_total) {
+        std::cout << "🎉 所有測試通過！\n";
+        return 0;
+    } else {
+        std::cout << "❌ 有 " << (tests_total - tests_passed) << " 個測試失敗\n";
+        return 1;
+    }
+}
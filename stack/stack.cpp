@@ -4,23 +4,35 @@
 #include <limits>
 #include <type_traits>
 
-template <typename T>
-class stack
+#include "../common/containerStats.cpp"
+#include "../common/mappedBuffer.cpp"
+
+template <typename T, typename Stats = defaultStatsRecorder>
+class stack : private Stats
 {
 private:
     T* data;
     std::size_t ptr;
     std::size_t cap;
     double growth = 2.0;
+    std::uint8_t mapFlags = 0;      // how data was allocated, see mappedBuffer.cpp
 
     void resize(size_t newCap){
         if(newCap <= cap){
             return;
         }
-        T* newData = nullptr;
+        relocate(newCap, mapFlags);
+    }
+
+    // move the elements into a fresh buffer allocated according to newFlags
+    void relocate(std::size_t newCap, std::uint8_t newFlags){
+        if(newFlags & mappedBuffer::mapped){
+            // use the whole mapping
+            newCap = mappedBuffer::mappedLength(newCap * sizeof(T), newFlags) / sizeof(T);
+        }
+        T* newData = mappedBuffer::allocate<T>(newCap, newFlags);
         try
         {
-            newData = new T[newCap];
             for(std::size_t i = 0; i < ptr; i++){
                 // checks whether type T has a noexcept move constructor
                 // if it does, return true, then false
@@ -34,12 +46,14 @@ private:
         }
         catch(...)
         {
-            delete [] newData;
+            mappedBuffer::release(newData, newCap, newFlags);
             throw;
         }
-        delete [] data;
+        mappedBuffer::release(data, cap, mapFlags);
         data = newData;
         cap = newCap;
+        mapFlags = newFlags;
+        this->recordResize(ptr * sizeof(T));
     }
 
     void ensureCapacity(){
@@ -62,13 +76,20 @@ private:
     }
     
 public:
+    // occupancy / resize telemetry, see containerStats.cpp
+    using Stats::stats;
+    using Stats::resetStats;
+    using Stats::statsEnabled;
+
     // ctor
     explicit stack(std::size_t cap): cap(cap), ptr(0){
         data = new T[cap];
     }
 
     // copy ctor
-    stack(const stack& other) : data(new T[other.cap]), ptr(other.ptr), cap(other.cap){
+    stack(const stack& other)
+     : Stats(other), data(mappedBuffer::allocate<T>(other.cap, other.mapFlags)), ptr(other.ptr), cap(other.cap),
+       mapFlags(other.mapFlags){
         for(std::size_t i = 0; i < ptr; i++){
             data[i] = other.data[i];
         }
@@ -76,9 +97,13 @@ public:
 
     // move ctor
     stack(stack&& other) noexcept
-     : data(std::exchange(other.data, nullptr)), 
+     : Stats(),
+       data(std::exchange(other.data, nullptr)), 
        ptr(std::exchange(other.ptr, 0)), 
-       cap(std::exchange(other.cap, 0)){}
+       cap(std::exchange(other.cap, 0)),
+       mapFlags(std::exchange(other.mapFlags, 0)){
+        this->swapStats(other);
+    }
 
     // copy & move assignment
     stack& operator=(stack other)noexcept{
@@ -88,13 +113,28 @@ public:
 
     // destructor
     ~stack()noexcept{
-        delete[] data;
+        mappedBuffer::release(data, cap, mapFlags);
     }
 
     void swap(stack& other) noexcept{
         std::swap(data, other.data);
         std::swap(ptr, other.ptr);
         std::swap(cap, other.cap);
+        std::swap(mapFlags, other.mapFlags);
+        this->swapStats(other);
+    }
+
+    // Linux: move into an mmap'ed buffer of at least n elements, 2 MiB aligned with
+    // MADV_HUGEPAGE (huge), mlock'ed (lock) and pre-touched (prefault), so pushes up to
+    // n never take a page fault. Later growth allocates the same way.
+    void reserve(std::size_t n, bool prefault = true, bool huge = true, bool lock = false){
+        std::uint8_t flags = static_cast<std::uint8_t>(mappedBuffer::mapped |
+            (prefault ? mappedBuffer::prefault : 0) | (huge ? mappedBuffer::huge : 0) |
+            (lock ? mappedBuffer::locked : 0));
+        if(n <= cap && flags == mapFlags){
+            return;
+        }
+        relocate(n > cap ? n : cap, flags);
     }
 
     void push(const T& value){
@@ -104,10 +144,12 @@ public:
         ensureCapacity();
         data[ptr] = value;
         ++ptr;
+        this->recordInsert(ptr);
     }
 
     void pop(){
         if(ptr == 0){
+            this->recordUnderflow();
             throw std::runtime_error("stack underflow : cannot pop with empty stack");
         }
         
@@ -118,6 +160,7 @@ public:
         if(ptr > 0){
             return data[ptr - 1];
         }
+        this->recordUnderflow();
         throw std::runtime_error("Cannot access top of empty stack");
     }
 
@@ -133,6 +176,10 @@ public:
         return ptr;
     }
 
+    size_t capacity() const noexcept{
+        return cap;
+    }
+
     void clear() noexcept{
         ptr = 0;
     }